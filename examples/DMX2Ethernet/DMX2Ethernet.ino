@@ -173,6 +173,7 @@ void setup() {
   
   LXSerialDMX.setDirectionPin(RXTX_PIN);
   LXSerialDMX.setDataReceivedCallback(&gotDMXCallback);
+  LXSerialDMX.setFrameBuffering(1);       // read complete frames (if RAM allows)
   LXSerialDMX.startInput();
 
   if ( use_multicast ) {
@@ -192,7 +193,11 @@ void setup() {
 // ***************** input callback function *************
 
 void gotDMXCallback(int slots) {
-  got_dmx = slots;
+  // frames with errors or cut short are not published by the driver,
+  // with frame buffering acquireFrame() then switches to the newest valid frame
+  if ( LXSerialDMX.lastFrameValid() ) {
+    got_dmx = slots;
+  }
 }
 
 
@@ -212,10 +217,9 @@ void gotPollReplyCallback(uint8_t* packet) {
 
 void loop() {
   if ( got_dmx ) {
+    LXSerialDMX.acquireFrame();
     interface->setNumberOfSlots(got_dmx);
-    for(int i=1; i<=got_dmx; i++) {
-      interface->setSlot(i, LXSerialDMX.getSlot(i));
-    }
+    interface->setSlots(1, got_dmx, &LXSerialDMX.dmxData()[1]);   // dmxData()[0] is start code
     blinkLED();
 
     //interface->setNumberOfSlots(512);
@@ -31,11 +31,15 @@
 #include <LXDMXEthernet.h>
 #include <LXArtNet.h>
 #include <LXSACN.h>
+#include <LXPixelMapper.h>
+#include <LXDMXCurve.h>
 
 //*********************** defines ***********************
 
 #define PIN 6
 #define NUM_LEDS 12
+// address of the first pixel's red channel
+#define START_ADDRESS 1
 
 //  Make choices here about protocol ( set to 1 to activate option )
 
@@ -67,10 +71,30 @@ Adafruit_NeoPixel ring = Adafruit_NeoPixel(NUM_LEDS, PIN, NEO_GRB + NEO_KHZ800);
 // LXDMXEthernet instance ( created in setup so its possible to get IP if DHCP is used )
 LXDMXEthernet* interface;
 
+// copies RGB slots into the staging buffer in the NeoPixel's GRB order
+LXPixelMapper mapper(NUM_LEDS, LXPIXEL_ORDER_RGB, LXPIXEL_ORDER_GRB);
+uint8_t pixels_changed = 0;
+
+// received levels before gamma correction
+// the curve is applied from here into the NeoPixel buffer so that pixels not in a packet
+// keep their level instead of having the curve applied to them again
+uint8_t staging[NUM_LEDS*3];
+
+// gamma correction table (or try LXDMX_CURVE_GAMMA_22)
+LXDMXCurve pixel_curve(LXDMX_CURVE_SQUARE);
+
 // sACN uses multicast, Art-Net uses broadcast. Both can be set to unicast (use_multicast = 0)
 uint8_t use_multicast = USE_SACN;
 
 
+//*********************** callback ***********************
+// called by readDMXPacket when DMX for the interface's universe is received
+void dmxReceived(uint16_t universe, uint8_t* data, uint16_t slots, uint16_t first_changed, uint16_t last_changed) {
+  if ( mapper.mapUniverse(universe, data, slots) ) {
+    pixels_changed = 1;
+  }
+}
+
 //*********************** setup ***********************
 void setup() {
 
@@ -97,6 +121,11 @@ void setup() {
     
   ring.begin();                   // Initialize NeoPixel driver
   ring.show();
+
+  // callback universe is the sACN universe or the Art-Net Port-Address
+  mapper.setStart(USE_SACN ? 1 : 0, START_ADDRESS);
+  mapper.setTarget(staging);
+  interface->setDMXReceivedCallback(&dmxReceived);
   
   if ( ! USE_SACN ) {
    ((LXArtNet*)interface)->setNodeName(ARTNET_NODE_NAME);
@@ -106,24 +135,13 @@ void setup() {
 
 //*********************** main loop *******************
 void loop() {
-  uint16_t r,g,b;
-  uint16_t i;
-  
-  // read a packet and if the packet is dmx, write its data to the pixels
-  if ( interface->readDMXPacket(&eUDP) == RESULT_DMX_RECEIVED ) {
-    for (int p=0; p<NUM_LEDS; p++) {
-      // for each NeoPixel find the slot number (each takes 3 slots for RGB)
-      i = 3*p;
-      r = interface->getSlot(i+1);  // Red
-      g = interface->getSlot(i+2);  // Green
-      b = interface->getSlot(i+3);  // Blue
-      // gamma correct
-      r = (r*r)/255;    
-      g = (g*g)/255;
-      b = (b*b)/255;
-      // write to NeoPixel Driver
-      ring.setPixelColor(p, r, g, b);
-    }
+  // read a packet, if it is dmx the callback copies it to the staging buffer
+  interface->readDMXPacket(&eUDP);
+
+  if ( pixels_changed ) {
+    pixels_changed = 0;
+    // gamma correct into the NeoPixel buffer
+    pixel_curve.apply8(staging, ring.getPixels(), NUM_LEDS*3);
     // send to NeoPixel Ring
     ring.show();
   }
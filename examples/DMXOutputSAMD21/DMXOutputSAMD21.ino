@@ -185,6 +185,7 @@ void setup() {
   }
 
   SAMD21DMX.setDirectionPin(RXTX_PIN);
+  SAMD21DMX.setFrameBuffering(1);         // output complete frames
   SAMD21DMX.startOutput();
   
   if ( ! USE_SACN ) {
@@ -207,9 +208,9 @@ void loop() {
 	uint8_t result = interface->readDMXPacket(&eUDP);
 
   if ( result == RESULT_DMX_RECEIVED ) {
-     for (int i = 1; i <= interface->numberOfSlots(); i++) {
-        SAMD21DMX.setSlot(i , interface->getSlot(i));
-     }
+     interface->getSlots(1, interface->numberOfSlots(), &SAMD21DMX.dmxData()[1]);   // dmxData()[0] is start code
+     SAMD21DMX.followSlots(interface->numberOfSlots());  // short universes refresh faster
+     SAMD21DMX.publishFrame();
      blinkLED();
   }
 }
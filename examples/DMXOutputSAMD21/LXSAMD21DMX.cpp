@@ -59,6 +59,7 @@ uint8_t   _shared_dmx_state;
 uint16_t  _shared_dmx_slot;
 uint16_t  _shared_max_slots = DMX_MIN_SLOTS;
 LXRecvCallback _shared_receive_callback = NULL;
+volatile uint32_t _shared_frame_count = 0;
 
 
 void setBaudRate(uint32_t baudrate) {
@@ -73,6 +74,13 @@ void setBaudRate(uint32_t baudrate) {
     DMX_SERCOM->USART.CTRLA.bit.ENABLE = 0x1u; // re-enable
 }
 
+void sendBreak( void ) {
+	setBaudRate(DMX_BREAK_BAUD);
+	_shared_dmx_state = DMX_STATE_START;
+	_shared_dmx_slot = 0;
+	DMX_SERCOM->USART.DATA.reg = 0;	//break
+}
+
 //************************************************************************************
 // ************************  LXSAMD21DMXOutput member functions  ********************
 
@@ -80,9 +88,9 @@ LXSAMD21DMX::LXSAMD21DMX ( void ) {
 	_direction_pin = DIRECTION_PIN_NOT_USED;	//optional
 	_shared_max_slots = DMX_MAX_SLOTS;
 	_interrupt_status = ISR_DISABLED;
-	
-	//zero buffer including _dmxData[0] which is start code
-    memset(_dmxData, 0, DMX_MAX_SLOTS+1);
+	_triggered_output = 0;
+	_follower.setMinimum(DMX_MIN_SLOTS);
+	//_frames are zeroed including [0] which is start code
 }
     
     
@@ -111,9 +119,13 @@ void LXSAMD21DMX::startOutput ( void ) {
 	  pinPeripheral(PIN_DMX_TX, PIO_SERCOM_ALT);
 	  
 	  _interrupt_status = ISR_OUTPUT_ENABLED;
-	  _shared_dmx_data = dmxData();
+	  _shared_dmx_data = _frames.readFrame();
 	  _shared_dmx_slot = 0;              
 	  _shared_dmx_state = DMX_STATE_START;
+	  if ( _triggered_output ) {
+	    _shared_dmx_state = DMX_STATE_BREAK;		// scheduler starts the first frame
+	    _scheduler.begin(micros());
+	  }
 
 	  SERCOM4->USART.INTENSET.reg =  SERCOM_USART_INTENSET_TXC | SERCOM_USART_INTENSET_ERROR;
 	  SERCOM4->USART.DATA.reg = 0;  
@@ -135,7 +147,7 @@ void LXSAMD21DMX::startInput ( void ) {
 	   pinPeripheral(PIN_DMX_RX, PIO_SERCOM_ALT);
 	   pinPeripheral(PIN_DMX_TX, PIO_SERCOM_ALT);
 	   
-		_shared_dmx_data = dmxData();
+		_shared_dmx_data = _frames.writeFrame();
 		_shared_dmx_slot = 0;              
 		_shared_dmx_state = DMX_STATE_IDLE;
 
@@ -161,16 +173,82 @@ void LXSAMD21DMX::setMaxSlots (int slots) {
 	}
 }
 
+void LXSAMD21DMX::followSlots (int slots) {
+	_shared_max_slots = _follower.update(slots);		// 16 bit store is atomic
+}
+
+LXDMXSlotFollower* LXSAMD21DMX::slotFollower (void) {
+	return &_follower;
+}
+
+uint32_t LXSAMD21DMX::frameCount (void) {
+	return _shared_frame_count;
+}
+
+uint16_t LXSAMD21DMX::refreshRate (void) {
+	return _rate.sample(frameCount(), millis());
+}
+
+LXDMXInputStats* LXSAMD21DMX::inputStats (void) {
+	return &_input_stats;
+}
+
+uint8_t LXSAMD21DMX::lastFrameValid (void) {
+	return _input_stats.lastFrameValid();
+}
+
 uint8_t LXSAMD21DMX::getSlot (int slot) {
-	return _dmxData[slot];
+	return dmxData()[slot];
 }
 
 void LXSAMD21DMX::setSlot (int slot, uint8_t value) {
-	_dmxData[slot] = value;
+	dmxData()[slot] = value;
 }
 
 uint8_t* LXSAMD21DMX::dmxData(void) {
-	return &_dmxData[0];
+	if ( _interrupt_status == ISR_INPUT_ENABLED ) {
+		return _frames.readFrame();
+	}
+	return _frames.writeFrame();
+}
+
+void LXSAMD21DMX::setFrameBuffering (uint8_t enable) {
+	if ( _interrupt_status == ISR_DISABLED ) {
+		_frames.setEnabled(enable);
+	}
+}
+
+void LXSAMD21DMX::publishFrame (void) {
+	_frames.publish(1);
+}
+
+uint8_t LXSAMD21DMX::acquireFrame (void) {
+	return _frames.acquire();
+}
+
+void LXSAMD21DMX::setTriggeredOutput (uint8_t enable) {
+	if ( _interrupt_status == ISR_DISABLED ) {
+		_triggered_output = enable;
+	}
+}
+
+void LXSAMD21DMX::triggerFrame (void) {
+	publishFrame();
+	_scheduler.trigger();
+}
+
+// TXC interrupt is disabled while idle, re-enabled after the break is written
+void LXSAMD21DMX::serviceOutput (void) {
+	if (( _interrupt_status == ISR_OUTPUT_ENABLED ) && _triggered_output ) {
+		if ( _scheduler.service(micros()) ) {
+			sendBreak();
+			DMX_SERCOM->USART.INTENSET.reg = SERCOM_USART_INTENSET_TXC;
+		}
+	}
+}
+
+LXDMXFrameScheduler* LXSAMD21DMX::frameScheduler (void) {
+	return &_scheduler;
 }
 
 void LXSAMD21DMX::setDataReceivedCallback(LXRecvCallback callback) {
@@ -191,12 +269,17 @@ void LXSAMD21DMX::IrqHandler(void) {
             _shared_dmx_state = DMX_STATE_BREAK;
           }
         } else if ( _shared_dmx_state == DMX_STATE_BREAK ) {
-          setBaudRate(DMX_BREAK_BAUD);
-          _shared_dmx_state = DMX_STATE_START;
-          _shared_dmx_slot = 0;
-          DMX_SERCOM->USART.DATA.reg = 0;	//break
+          if ( _triggered_output && ( ! _scheduler.frameComplete(micros()) )) {
+            _shared_dmx_state = DMX_STATE_IDLE;	// line marks until serviceOutput()
+            DMX_SERCOM->USART.INTENCLR.reg = SERCOM_USART_INTENCLR_TXC;
+          } else {
+            sendBreak();
+          }
         } else if ( _shared_dmx_state == DMX_STATE_START ) {
           setBaudRate(DMX_DATA_BAUD);
+          _shared_frame_count++;
+          _frames.acquire();								// start frame on most recently published data
+          _shared_dmx_data = _frames.readFrame();
           _shared_dmx_state = DMX_STATE_DATA;
           DMX_SERCOM->USART.DATA.reg = _shared_dmx_data[_shared_dmx_slot++];
         }
@@ -210,8 +293,21 @@ void LXSAMD21DMX::IrqHandler(void) {
 		   DMX_SERCOM->USART.INTFLAG.bit.ERROR = 1;		//acknowledge error, clear interrupt
 		   
 			if ( DMX_SERCOM->USART.STATUS.bit.FERR ) {	//framing error happens when break is sent
+				uint8_t incoming_byte = DMX_SERCOM->USART.DATA.reg;		// read so break is not taken as start code
+				DMX_SERCOM->USART.STATUS.reg = SERCOM_USART_STATUS_FERR;	// clear status
+				if ( incoming_byte != 0 ) {						// not a break, ignore rest of frame
+					_input_stats.framingError();
+					_shared_dmx_state = DMX_STATE_IDLE;
+					return;
+				}
+				_input_stats.breakReceived(micros(), _shared_dmx_slot);
 				_shared_dmx_state = DMX_STATE_BREAK;
 				if ( _shared_dmx_slot > 0 ) {
+					_shared_frame_count++;
+					if ( _input_stats.lastFrameValid() ) {	// otherwise the next frame overwrites it
+						_frames.publish(0);
+						_shared_dmx_data = _frames.writeFrame();
+					}
 					if ( _shared_receive_callback != NULL ) {
 						_shared_receive_callback(_shared_dmx_slot);
 					}
@@ -227,8 +323,9 @@ void LXSAMD21DMX::IrqHandler(void) {
 		uint8_t incoming_byte = DMX_SERCOM->USART.DATA.reg;				// read buffer to clear interrupt flag
 			switch ( _shared_dmx_state ) {
 				case DMX_STATE_BREAK:
+					_input_stats.startCode(incoming_byte);
 					if ( incoming_byte == 0 ) {									// start code == zero (DMX)
-						_shared_dmx_data[_shared_dmx_slot] = incoming_byte;
+						_shared_dmx_data[_shared_dmx_slot++] = incoming_byte;
 						_shared_dmx_state = DMX_STATE_DATA;
 					} else {
 						_shared_dmx_state = DMX_STATE_IDLE;
@@ -57,6 +57,11 @@ TX (4) |----------------------| 4 DI   Gnd 5 |---+------------ Pin 1
 
 #include <inttypes.h>
 #include "SERCOM.h"
+#include <LXDMXTripleBuffer.h>
+#include <LXDMXFrameScheduler.h>
+#include <LXDMXSlotFollower.h>
+#include <LXDMXRateMeter.h>
+#include <LXDMXInputStats.h>
 
 #define DMX_MIN_SLOTS 24
 #define DMX_MAX_SLOTS 512
@@ -77,6 +82,27 @@ typedef void (*LXRecvCallback)(int);
    Use getSlot() to read the level value for a particular DMX dimmer/address/channel.
    
    LXSAMD21DMX is used with a single instance called SAMD21DMX	.
+   
+   With setFrameBuffering(1), frames are triple buffered between the loop and the ISR.
+   For output, write the frame with setSlot() and call publishFrame() when it is complete.
+   The ISR starts each DMX frame on the most recently published frame.
+   For input, the ISR publishes each valid frame on the following break.  A frame
+   with errors or cut short is not published and the next frame is read over it.
+   Call acquireFrame() before reading with getSlot() to switch to the newest valid frame.
+   
+   With setTriggeredOutput(1), output is not free running.  Call triggerFrame() when
+   a new frame is written and serviceOutput() from loop.  A frame starts as soon as
+   the one being sent is complete, or immediately if the line is idle, subject to the
+   minimum break to break time.  Without triggers, the last frame is repeated at the
+   keep alive interval of frameScheduler().
+   
+   followSlots() sets the number of slots sent from the number received, so
+   short universes are sent at a higher refresh rate.  refreshRate() reports the
+   frames per second actually sent.
+   
+   In input mode, inputStats() counts frames, framing errors, short frames and
+   alternate start codes.  lastFrameValid() tells if the most recently received
+   frame was complete.
 */
 
 class LXSAMD21DMX  {
@@ -123,9 +149,91 @@ class LXSAMD21DMX  {
 	*/
 	void setMaxSlots (int slot);
 	
+	/*!
+	 * @brief Sets the number of slots sent from the number of slots received
+	 * @discussion Call with numberOfSlots() of each received packet.  The count increases
+	 *             immediately and decreases after several shorter frames, see LXDMXSlotFollower.
+	 * @param slots number of slots received
+	*/
+	void followSlots (int slots);
+	
+	/*!
+	 * @brief Hysteresis of followSlots()
+	*/
+	LXDMXSlotFollower* slotFollower (void);
+	
+	/*!
+	 * @brief Number of frames started or received by the ISR
+	*/
+	uint32_t frameCount (void);
+	
+	/*!
+	 * @brief Frames per second sent or received
+	 * @discussion Measured over about a second, call at least once per second.
+	*/
+	uint16_t refreshRate (void);
+	
+	/*!
+	 * @brief Counts of received frames and errors, see LXDMXInputStats
+	*/
+	LXDMXInputStats* inputStats (void);
+	
+	/*!
+	 * @brief Checks the most recently received frame
+	 * @return 1 if it had a null start code, no framing error and was not short
+	*/
+	uint8_t lastFrameValid (void);
+	
+	/*!
+	 * @brief Enables triple buffering of frames between loop and ISR
+	 * @discussion Call before startOutput() or startInput().
+	 *             Enabling allocates two more frames (1026 bytes), disabling frees them.
+	 * @param enable 1 to buffer frames, 0 for single buffer shared with ISR
+	*/
+	void setFrameBuffering (uint8_t enable);
+	
+	/*!
+	 * @brief Hands the frame written with setSlot() to the ISR
+	 * @discussion Only needed with frame buffering.  Slots not changed before the
+	 *             next publishFrame() keep their published values.
+	*/
+	void publishFrame (void);
+	
+	/*!
+	 * @brief Switches getSlot() and dmxData() to the most recently received frame
+	 * @discussion Only needed with frame buffering.  Only valid frames are published.
+	 * @return 1 if a new valid frame is available
+	*/
+	uint8_t acquireFrame (void);
+	
+	/*!
+	 * @brief Starts frames when new data is triggered instead of continuously
+	 * @discussion Call before startOutput().
+	 * @param enable 1 for triggered output, 0 for free running
+	*/
+	void setTriggeredOutput (uint8_t enable);
+	
+	/*!
+	 * @brief Publishes the frame written with setSlot() and requests that it be sent
+	 * @discussion With triggered output, the frame starts when the current frame
+	 *             is complete or on the next serviceOutput() if the line is idle.
+	*/
+	void triggerFrame (void);
+	
+	/*!
+	 * @brief Starts a frame if the output is idle and one is due
+	 * @discussion Call from loop with triggered output.
+	*/
+	void serviceOutput (void);
+	
+	/*!
+	 * @brief Timing of triggered output, see LXDMXFrameScheduler
+	*/
+	LXDMXFrameScheduler* frameScheduler (void);
+	
 	/*!
     * @brief reads the value of a slot/address/channel
-    * @discussion NOTE: Data is not double buffered.  
+    * @discussion NOTE: Without frame buffering data is not double buffered.  
     *                   So a complete single frame is not guaranteed.  
     *                   The ISR continuously reads the next frame into the buffer
     * @return level (0-255)
@@ -141,6 +249,8 @@ class LXSAMD21DMX  {
    
    /*!
     * @brief provides direct access to data array
+    * @discussion With frame buffering, this is the frame owned by the loop:
+    *             the one being written for output or the last acquired for input.
     * @return pointer to dmx array
    */
    uint8_t* dmxData(void);
@@ -171,9 +281,26 @@ class LXSAMD21DMX  {
   	uint8_t _direction_pin;
   	
   	/*!
-    * @brief Array of dmx data including start code
+    * @brief Frames of dmx data including start code
+   */
+  	LXDMXTripleBuffer  _frames;
+  	
+  	/*!
+    * @brief Starts output frames when triggered
+   */
+  	LXDMXFrameScheduler _scheduler;
+  	uint8_t  _triggered_output;
+  	
+  	/*!
+    * @brief Output slot count from received slots and measured frame rate
+   */
+  	LXDMXSlotFollower _follower;
+  	LXDMXRateMeter    _rate;
+  	
+  	/*!
+    * @brief Counts kept by the ISR in input mode
    */
-  	uint8_t  _dmxData[DMX_MAX_SLOTS+1];
+  	LXDMXInputStats   _input_stats;
   	
 };
 
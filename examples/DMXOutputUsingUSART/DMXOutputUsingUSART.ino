@@ -30,7 +30,7 @@ TX |----------------------| 4 DI   Gnd 5 |---+------------ Pin 1
 
 
  Created January 7th, 2014 by Claude Heintz
- Current version 1.5
+ Current version 1.6
  (see bottom of file for revision history)
 
  See LXArduinoDMXUSART.h or http://lx.claudeheintzdesign.com/opensource.html for license.
@@ -197,6 +197,8 @@ void setup() {
   }
 
   LXSerialDMX.setDirectionPin(RXTX_PIN);
+  LXSerialDMX.setFrameBuffering(1);       // output complete frames (if RAM allows)
+  LXSerialDMX.setTriggeredOutput(1);      // start a frame when a packet arrives
   LXSerialDMX.startOutput();
   
   if ( ! USE_SACN ) {
@@ -229,11 +231,12 @@ void loop() {
 	uint8_t result = interface->readDMXPacket(&eUDP);
 
   if ( result == RESULT_DMX_RECEIVED ) {
-     for (int i = 1; i <= interface->numberOfSlots(); i++) {
-        LXSerialDMX.setSlot(i , interface->getSlot(i));
-     }
+     interface->getSlots(1, interface->numberOfSlots(), &LXSerialDMX.dmxData()[1]);   // dmxData()[0] is start code
+     LXSerialDMX.followSlots(interface->numberOfSlots());  // short universes refresh faster
+     LXSerialDMX.triggerFrame();
      blinkLED();
   }
+  LXSerialDMX.serviceOutput();            // send waiting frame or keep alive if line is idle
 }
 
 /*
@@ -244,4 +247,5 @@ void loop() {
     v1.3 moved control of options to "includes" and "defines"
     v1.4 uses LXArtNet class which encapsulates Art-Net functionality
     v1.5 revised as example file for library
+    v1.6 output frames triggered by received packets
 */
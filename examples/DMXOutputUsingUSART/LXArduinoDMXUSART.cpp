@@ -129,10 +129,26 @@ LXUSARTDMX LXSerialDMX;
 // **************************** global data (can be accessed in ISR)  ***************
 
 uint8_t*  _shared_dmx_data;
+LXDMXTripleBuffer* _shared_frames;
+LXDMXFrameScheduler* _shared_scheduler = NULL;
+LXDMXInputStats* _shared_input_stats;
 uint8_t   _shared_dmx_state;
 uint16_t  _shared_dmx_slot;
 uint16_t  _shared_max_slots = DMX_MIN_SLOTS;
 LXRecvCallback _shared_receive_callback = NULL;
+volatile uint32_t _shared_frame_count = 0;
+
+// ***** send_break *****
+// set the slower baud rate and send the break
+
+static inline void send_break( void ) {
+	LXUCSRRH = (unsigned char)(((F_CLK + DMX_BREAK_BAUD * 8L) / (DMX_BREAK_BAUD * 16L) - 1)>>8);
+	LXUCSRRL = (unsigned char) ((F_CLK + DMX_BREAK_BAUD * 8L) / (DMX_BREAK_BAUD * 16L) - 1);
+	LXUCSRA &= ~BIT_2X_SPEED;
+	LXUCSRC = FORMAT_8E1;
+	_shared_dmx_state = DMX_STATE_START;
+	LXUDR = 0x0;
+}
 
 
 //************************************************************************************
@@ -142,11 +158,9 @@ LXUSARTDMX::LXUSARTDMX ( void ) {
 	_direction_pin = DIRECTION_PIN_NOT_USED;	//optional
 	_shared_max_slots = DMX_MAX_SLOTS;
 	_interrupt_status = ISR_DISABLED;
-	
-	//zero buffer including _dmxData[0] which is start code
-    for (int n=0; n<DMX_MAX_SLOTS+1; n++) {
-    	_dmxData[n] = 0;
-    }
+	_triggered_output = 0;
+	_follower.setMinimum(DMX_MIN_SLOTS);
+	//_frames are zeroed including [0] which is start code
 }
 
 
@@ -174,8 +188,15 @@ void LXUSARTDMX::startOutput ( void ) {
 		LXUCSRA &= ~BIT_2X_SPEED;
 
 		LXUDR = 0x0;     			//USART send register  
-		_shared_dmx_data = dmxData();                 
+		_shared_frames = &_frames;
+		_shared_dmx_data = _frames.readFrame();
 		_shared_dmx_state = DMX_STATE_BREAK;
+		if ( _triggered_output ) {
+			_scheduler.begin(micros());
+			_shared_scheduler = &_scheduler;
+		} else {
+			_shared_scheduler = NULL;
+		}
 
 		LXUCSRC = FORMAT_8N2; 					//set length && stopbits (no parity)
 		LXUCSRB |= BIT_TX_ENABLE | BIT_TX_ISR_ENABLE;  //enable tx and tx interrupt
@@ -200,9 +221,11 @@ void LXUSARTDMX::startInput ( void ) {
 		LXUCSRRL = (unsigned char) ((F_CLK + DMX_DATA_BAUD * 8L) / (DMX_DATA_BAUD * 16L) - 1);
 		LXUCSRA &= ~BIT_2X_SPEED;
 
-		_shared_dmx_data = dmxData();                 
+		_shared_frames = &_frames;
+		_shared_dmx_data = _frames.writeFrame();
 		_shared_dmx_state = DMX_STATE_IDLE;
 		_shared_dmx_slot = 0;
+		_shared_input_stats = &_input_stats;
 	
 		LXUCSRC = FORMAT_8N2; 					//set length && stopbits (no parity)
 		LXUCSRB |= BIT_RX_ENABLE | BIT_RX_ISR_ENABLE;  //enable tx and tx interrupt
@@ -240,26 +263,126 @@ void LXUSARTDMX::setMaxSlots (int slots) {
 	_shared_max_slots = max(slots, DMX_MIN_SLOTS);
 }
 
+//  ***** followSlots *****
+//  sets the number of slots sent per DMX frame from the number received
+//  with hysteresis so that alternating lengths don't change the frame rate
+
+void LXUSARTDMX::followSlots (int slots) {
+	uint16_t s = _follower.update(slots);
+	LXDMX_CRITICAL_BEGIN
+	_shared_max_slots = s;
+	LXDMX_CRITICAL_END
+}
+
+LXDMXSlotFollower* LXUSARTDMX::slotFollower (void) {
+	return &_follower;
+}
+
+//  ***** frameCount *****
+//  frames started by the TX ISR or received by the RX ISR, read with interrupts off
+
+uint32_t LXUSARTDMX::frameCount (void) {
+	LXDMX_CRITICAL_BEGIN
+	uint32_t n = _shared_frame_count;
+	LXDMX_CRITICAL_END
+	return n;
+}
+
+uint16_t LXUSARTDMX::refreshRate (void) {
+	return _rate.sample(frameCount(), millis());
+}
+
+//  ***** inputStats *****
+//  counts kept by the RX ISR
+
+LXDMXInputStats* LXUSARTDMX::inputStats (void) {
+	return &_input_stats;
+}
+
+uint8_t LXUSARTDMX::lastFrameValid (void) {
+	return _input_stats.lastFrameValid();
+}
+
 //  ***** getSlot *****
 //  reads the value of a slot
 //  see buffering note for ISR below 
 
 uint8_t LXUSARTDMX::getSlot (int slot) {
-	return _dmxData[slot];
+	return dmxData()[slot];
 }
 
 //  ***** setSlot *****
 //  sets the output value of a slot
 
 void LXUSARTDMX::setSlot (int slot, uint8_t value) {
-	_dmxData[slot] = value;
+	dmxData()[slot] = value;
 }
 
 //  ***** dmxData *****
-//  pointer to data buffer
+//  pointer to data buffer owned by loop
+//  (same for all when frame buffering is not enabled)
 
 uint8_t* LXUSARTDMX::dmxData(void) {
-	return &_dmxData[0];
+	if ( _interrupt_status == ISR_INPUT_ENABLED ) {
+		return _frames.readFrame();
+	}
+	return _frames.writeFrame();
+}
+
+//  ***** setFrameBuffering *****
+//  separate frames for loop and ISR
+
+void LXUSARTDMX::setFrameBuffering (uint8_t enable) {
+	if ( _interrupt_status == ISR_DISABLED ) {
+		_frames.setEnabled(enable);
+	}
+}
+
+//  ***** publishFrame *****
+//  output frame is complete, TX ISR uses it on next break
+
+void LXUSARTDMX::publishFrame (void) {
+	_frames.publish(1);
+}
+
+//  ***** acquireFrame *****
+//  switch to most recent frame completed by RX ISR
+
+uint8_t LXUSARTDMX::acquireFrame (void) {
+	return _frames.acquire();
+}
+
+//  ***** setTriggeredOutput *****
+//  TX ISR idles after a frame unless another has been triggered
+
+void LXUSARTDMX::setTriggeredOutput (uint8_t enable) {
+	if ( _interrupt_status == ISR_DISABLED ) {
+		_triggered_output = enable;
+	}
+}
+
+//  ***** triggerFrame *****
+//  publish and send as soon as allowed
+
+void LXUSARTDMX::triggerFrame (void) {
+	publishFrame();
+	_scheduler.trigger();
+}
+
+//  ***** serviceOutput *****
+//  restart an idle line with a break when a frame is due
+//  no TX interrupt is pending while idle so the ISR's registers are free
+
+void LXUSARTDMX::serviceOutput (void) {
+	if (( _interrupt_status == ISR_OUTPUT_ENABLED ) && _triggered_output ) {
+		if ( _scheduler.service(micros()) ) {
+			send_break();
+		}
+	}
+}
+
+LXDMXFrameScheduler* LXUSARTDMX::frameScheduler (void) {
+	return &_scheduler;
 }
 
 //  ***** setDataReceivedCallback *****
@@ -290,19 +413,21 @@ void LXUSARTDMX::setDataReceivedCallback(LXRecvCallback callback) {
 // and then on the next ISR...
 // the next data byte is sent
 // and the cycle repeats...
+//
+// with triggered output, at the end of a frame the scheduler decides
+// whether to send the break or to leave the line marking (idle)
+// until serviceOutput() sends the break
 
 
 ISR (LXUSART_TX_vect) {
 	switch ( _shared_dmx_state ) {
 	   
 		case DMX_STATE_BREAK:
-			// set the slower baud rate and send the break
-			LXUCSRRH = (unsigned char)(((F_CLK + DMX_BREAK_BAUD * 8L) / (DMX_BREAK_BAUD * 16L) - 1)>>8);
-			LXUCSRRL = (unsigned char) ((F_CLK + DMX_BREAK_BAUD * 8L) / (DMX_BREAK_BAUD * 16L) - 1);
-			LXUCSRA &= ~BIT_2X_SPEED;
-			LXUCSRC = FORMAT_8E1;
-			_shared_dmx_state = DMX_STATE_START;
-			LXUDR = 0x0;
+			if (( _shared_scheduler != NULL ) && ( ! _shared_scheduler->frameComplete(micros()) )) {
+				_shared_dmx_state = DMX_STATE_IDLE;
+				break;
+			}
+			send_break();
 			break;		// <- DMX_STATE_BREAK
 			
 		case DMX_STATE_START:
@@ -312,6 +437,9 @@ ISR (LXUSART_TX_vect) {
 			LXUCSRA &= ~BIT_2X_SPEED;
 			LXUCSRC = FORMAT_8N2;
 			_shared_dmx_slot = 0;	
+			_shared_frame_count++;
+			_shared_frames->acquire();						//start frame on most recently published data
+			_shared_dmx_data = _shared_frames->readFrame();
 			LXUDR = _shared_dmx_data[_shared_dmx_slot++];	//send next slot (start code)
 			_shared_dmx_state = DMX_STATE_DATA;
 			break;		// <- DMX_STATE_START
@@ -334,17 +462,33 @@ ISR (LXUSART_TX_vect) {
 // then on next receive:  check start code
 // then on next receive:  read data until done (in which case idle)
 //
-//  NOTE: data is not double buffered
+// a break is a framing error with a zero byte, a framing error with any other
+// byte is counted as an error and the rest of the frame is ignored
+//
+//  NOTE: unless frame buffering is enabled, data is not double buffered
 //  so a complete single frame is not guaranteed
 //  the ISR will continue to read the next frame into the buffer
+//  with frame buffering the frame is published on the break that follows it,
+//  only if it is valid so acquireFrame() never switches to a frame with errors
 
 ISR (LXUSART_RX_vect) {
 	uint8_t status_register = LXUCSRA;
   	uint8_t incoming_byte = LXUDR;
 	
 	if ( status_register & BIT_FRAME_ERROR ) {
+		if ( incoming_byte != 0 ) {
+			_shared_input_stats->framingError();
+			_shared_dmx_state = DMX_STATE_IDLE;
+			return;
+		}
+		_shared_input_stats->breakReceived(micros(), _shared_dmx_slot);
 		_shared_dmx_state = DMX_STATE_BREAK;
 		if ( _shared_dmx_slot > 0 ) {
+			_shared_frame_count++;
+			if ( _shared_input_stats->lastFrameValid() ) {	// otherwise the next frame overwrites it
+				_shared_frames->publish(0);
+				_shared_dmx_data = _shared_frames->writeFrame();
+			}
 			if ( _shared_receive_callback != NULL ) {
 				_shared_receive_callback(_shared_dmx_slot);
 			}
@@ -356,6 +500,7 @@ ISR (LXUSART_RX_vect) {
 	switch ( _shared_dmx_state ) {
 	
 		case DMX_STATE_BREAK:
+			_shared_input_stats->startCode(incoming_byte);
 			if ( incoming_byte == 0 ) {						//start code == zero (DMX)
 				_shared_dmx_state = DMX_STATE_DATA;
 				_shared_dmx_slot = 1;
@@ -371,4 +516,4 @@ ISR (LXUSART_RX_vect) {
 			}
 			break;
 	}
-}
\ No newline at end of file
+}
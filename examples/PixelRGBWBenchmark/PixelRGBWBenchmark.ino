@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*!
+    @file     PixelRGBWBenchmark.ino
+    @author   Claude Heintz
+    @license  BSD (see LXDMXEthernet.h)
+    @copyright 2026 by Claude Heintz
+
+    Measures pixels per second converted from RGB to RGBW by LXPixelRGBW
+    and prints the results to the serial monitor.
+    The same passes can be run on a host with extras/host/PixelRGBWBenchmark.cpp.
+
+	See LXDMXEthernet.h or http://lx.claudeheintzdesign.com/opensource.html for license.
+    
+    @section  HISTORY
+
+    v1.00 - First release
+    
+    
+//*********************** includes ***********************/
+
+#include <LXPixelRGBW.h>
+
+//*********************** defines ***********************
+
+// one universe of RGB pixels
+#define NUM_PIXELS 170
+#define PASSES 100
+
+//*********************** globals ***********************
+
+uint8_t rgb[NUM_PIXELS * 3];
+uint8_t rgbw[NUM_PIXELS * 4];
+
+LXPixelRGBW converter(LXPIXEL_ORDER_GRBW);
+
+//*********************** setup ***********************
+
+void benchmark(const char* name) {
+  unsigned long start = micros();
+  for (int n=0; n<PASSES; n++) {
+    rgb[0] = n;                     // keep the compiler from skipping passes
+    converter.convert(rgb, rgbw, NUM_PIXELS);
+  }
+  unsigned long elapsed = micros() - start;
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((float)NUM_PIXELS * PASSES * 1000000.0 / elapsed);
+  Serial.println(" pixels/sec");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while ( ! Serial ) {}
+
+  for (int i=0; i<NUM_PIXELS * 3; i++) {
+    rgb[i] = random(256);
+  }
+
+  converter.setMode(LXPIXEL_WHITE_MIN);
+  benchmark("min");
+
+  converter.setMode(LXPIXEL_WHITE_CALIBRATED);
+  converter.setWhitePoint(256, 200, 150);      // warm white
+  benchmark("calibrated");
+
+  converter.setBalance(256, 240, 220, 256);
+  benchmark("calibrated + balance");
+}
+
+//*********************** main loop *******************
+
+void loop() {
+}
@@ -51,6 +51,7 @@
 #include <LXDMXEthernet.h>
 #include <LXArtNet.h>
 #include <LXSACN.h>
+#include <LXDMXDispatcher.h>
 
 //*********************** defines ***********************
 
@@ -69,6 +70,9 @@ LXDMXEthernet* interfaceUniverse2;
 // buffer large enough to contain incoming packet
 uint8_t packetBuffer[SACN_BUFFER_MAX];
 
+// reads packets into packetBuffer and passes each to the interface for its universe
+LXDMXDispatcher dispatcher(packetBuffer, SACN_BUFFER_MAX);
+
 //*********************** globals ***********************
 
 // network addresses
@@ -102,10 +106,14 @@ void setup() {
     interface = new LXSACN(&packetBuffer[0]);
     interfaceUniverse2 = new LXSACN(&packetBuffer[0]);
     interfaceUniverse2->setUniverse(2);	         // for different universe, change this line and the multicast address below
+    dispatcher.addReceiver((LXSACN*)interface);
+    dispatcher.addReceiver((LXSACN*)interfaceUniverse2);
   } else {
     interface = new LXArtNet(Ethernet.localIP(), Ethernet.subnetMask(), &packetBuffer[0]);
     interfaceUniverse2 = new LXArtNet(Ethernet.localIP(), Ethernet.subnetMask(), &packetBuffer[0]);
     ((LXArtNet*)interfaceUniverse2)->setSubnetUniverse(0, 1);  //for different subnet/universe, change this line
+    dispatcher.addReceiver((LXArtNet*)interface);               // first Art-Net receiver also answers polls
+    dispatcher.addReceiver((LXArtNet*)interfaceUniverse2);
     use_multicast = 0;
   }
 
@@ -122,38 +130,43 @@ void setup() {
 	pinMode(3, OUTPUT);
 	pinMode(5, OUTPUT);
 	
+	interface->setDMXReceivedCallback(&gotUniverse1);
+	interfaceUniverse2->setDMXReceivedCallback(&gotUniverse2);
+	
 	ring.begin();                   // Initialize NeoPixel driver
   ring.show();
 }
 
 /************************************************************************
 
-  The main loop checks for and reads packets from  UDP socket
-  connection.  readDMXPacketContents() returns RESULT_DMX_RECEIVED when a DMX packet is received.
-  If the first universe does not match, try the second
+  Callbacks are called for each universe when DMX is received.
+  data points to slot 1 so slot n is data[n-1]
+
+*************************************************************************/
+
+void gotUniverse1(uint16_t universe, uint8_t* data, uint16_t slots, uint16_t first_changed, uint16_t last_changed) {
+  // edge case test universe 1, slot 1
+  analogWrite(3, data[0]);
+  ring.setPixelColor(1, data[0], data[1], data[2]);
+  ring.show();
+}
+
+void gotUniverse2(uint16_t universe, uint8_t* data, uint16_t slots, uint16_t first_changed, uint16_t last_changed) {
+  // edge case test 2nd universe, slot 512
+  analogWrite(5, data[511]);
+  ring.setPixelColor(8, data[509], data[510], data[511]);
+  ring.show();
+}
+
+/************************************************************************
+
+  The main loop reads all waiting packets from the UDP socket.
+  The dispatcher reads the universe from each packet and passes it
+  to the matching interface.  Art polls go to the first interface.
+  DMX is delivered to the callbacks above.
 
 *************************************************************************/
 
 void loop() {
-  uint16_t packetSize = eUDP.parsePacket();
-  if ( packetSize ) {
-  	  packetSize = eUDP.read(packetBuffer, SACN_BUFFER_MAX);
-	  uint8_t read_result = interface->readDMXPacketContents(&eUDP, packetSize);
-	  uint8_t read_result2 = 0;
-
-	  if ( read_result == RESULT_DMX_RECEIVED ) {
-	     // edge case test universe 1, slot 1
-	     analogWrite(3,interface->getSlot(1));
-       ring.setPixelColor(1, interface->getSlot(1), interface->getSlot(2), interface->getSlot(3));
-	     ring.show();
-	  } else if ( read_result == RESULT_NONE ) {				// if not good dmx first universe (or art poll), try 2nd
-	     read_result2 = interfaceUniverse2->readDMXPacketContents(&eUDP, packetSize);
-	     if ( read_result2 == RESULT_DMX_RECEIVED ) {
-	     		// edge case test 2nd universe, slot 512
-		  		analogWrite(5,interfaceUniverse2->getSlot(512));
-          ring.setPixelColor(8, interface->getSlot(510), interface->getSlot(511), interface->getSlot(512));
-	        ring.show();
-	     }
-	  }
-	}
+  dispatcher.dispatchPackets(&eUDP);
 }
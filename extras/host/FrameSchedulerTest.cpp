@@ -0,0 +1,251 @@
+/* FrameSchedulerTest.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   Host test of LXDMXFrameScheduler driving a simulated UART.
+
+   g++ -O2 -I../../src FrameSchedulerTest.cpp -o FrameSchedulerTest && ./FrameSchedulerTest
+
+   The simulated UART sends a break and mark after break followed by the start
+   code and slots at 44us each, then calls frameComplete() as the TX ISR does.
+   The loop calls service() every LOOP_PERIOD microseconds and trigger() at
+   the times of each scenario.  Every break is recorded and checked:
+
+   trigger     a trigger starts a frame as soon as the minimum break to break
+               time allows, at the end of the current frame or from idle
+   idle        without triggers no frame is sent until the keep alive interval
+   keep alive  without triggers frames repeat at the keep alive interval
+   timing      no two breaks are closer than the minimum break to break time
+               and no trigger is lost
+*/
+
+#include <stdio.h>
+#include "LXDMXFrameScheduler.h"
+
+#define BREAK_AND_MAB	(88 + 12)		// microseconds
+#define SLOT_TIME		44
+#define LOOP_PERIOD		10				// service() is called this often
+#define MAX_BREAKS		20000
+#define MAX_TRIGGERS	20000
+
+static uint32_t breaks[MAX_BREAKS];
+static uint32_t break_count;
+
+class SimulatedUART {
+  public:
+	SimulatedUART ( LXDMXFrameScheduler* scheduler, uint16_t slots ) {
+		_scheduler = scheduler;
+		_slots = slots;
+		_sending = 0;
+	}
+
+	uint32_t frameTime ( void ) {
+		return BREAK_AND_MAB + SLOT_TIME * ( _slots + 1 );
+	}
+
+	void begin ( uint32_t now ) {			// as the driver's startOutput()
+		_scheduler->begin(now);
+		complete(now);
+	}
+
+	void tick ( uint32_t now ) {
+		if ( _sending && ( now >= _frame_end )) {
+			complete(now);
+		}
+	}
+
+	void sendBreak ( uint32_t now ) {
+		if ( break_count < MAX_BREAKS ) {
+			breaks[break_count++] = now;
+		}
+		_sending = 1;
+		_frame_end = now + frameTime();
+	}
+
+  private:
+	LXDMXFrameScheduler* _scheduler;
+	uint16_t _slots;
+	uint8_t  _sending;
+	uint32_t _frame_end;
+
+	void complete ( uint32_t now ) {		// TX ISR after the last slot
+		_sending = 0;
+		if ( _scheduler->frameComplete(now) ) {
+			sendBreak(now);
+		}
+	}
+};
+
+static uint32_t rng_state = 12345;
+
+static uint32_t next_random ( void ) {		// xorshift32
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= rng_state << 5;
+	return rng_state;
+}
+
+// run the loop until end, triggering at the given times
+static void simulate ( LXDMXFrameScheduler* scheduler, SimulatedUART* uart,
+					   const uint32_t* triggers, uint32_t trigger_count, uint32_t end ) {
+	break_count = 0;
+	uint32_t ti = 0;
+	uart->begin(0);
+	for (uint32_t now=0; now<end; now++) {
+		while (( ti < trigger_count ) && ( triggers[ti] == now )) {
+			scheduler->trigger();
+			ti++;
+		}
+		uart->tick(now);
+		if (( now % LOOP_PERIOD ) == 0 ) {
+			if ( scheduler->service(now) ) {
+				uart->sendBreak(now);
+			}
+		}
+	}
+}
+
+static int check_min_break_to_break ( const char* name, uint32_t min ) {
+	for (uint32_t i=1; i<break_count; i++) {
+		if ( breaks[i] - breaks[i-1] < min ) {
+			printf("  %s: breaks at %lu and %lu\n", name, (unsigned long)breaks[i-1], (unsigned long)breaks[i]);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// first break at or after t, 0xffffffff if none
+static uint32_t break_after ( uint32_t t ) {
+	for (uint32_t i=0; i<break_count; i++) {
+		if ( breaks[i] >= t ) {
+			return breaks[i];
+		}
+	}
+	return 0xffffffff;
+}
+
+static int expect_break ( const char* name, uint32_t at ) {
+	uint32_t b = break_after(at);
+	if ( b != at ) {
+		printf("  %s: expected break at %lu, next is %lu\n", name, (unsigned long)at, (unsigned long)b);
+		return 1;
+	}
+	return 0;
+}
+
+// 512 slot frames are longer than the minimum, a trigger goes out at the end of the frame
+static int test_trigger_full_frames ( void ) {
+	LXDMXFrameScheduler scheduler;
+	SimulatedUART uart(&scheduler, 512);
+	uint32_t ft = uart.frameTime();
+	uint32_t triggers[] = { ft / 2 };
+	simulate(&scheduler, &uart, triggers, 1, 3 * ft);
+	int errors = 0;
+	errors += expect_break("trigger full frame", ft);
+	if ( break_count != 2 ) {
+		printf("  trigger full frame: %lu breaks\n", (unsigned long)break_count);
+		errors++;
+	}
+	return errors;
+}
+
+// 8 slot frames are shorter than the minimum, a trigger waits for it from idle
+static int test_trigger_short_frames ( void ) {
+	LXDMXFrameScheduler scheduler;
+	SimulatedUART uart(&scheduler, 8);
+	uint32_t triggers[] = { 100, 5000 };
+	simulate(&scheduler, &uart, triggers, 2, 10000);
+	int errors = 0;
+	errors += expect_break("trigger short frame", LXDMX_MIN_BREAK_TO_BREAK / LOOP_PERIOD * LOOP_PERIOD + LOOP_PERIOD);
+	errors += expect_break("trigger from idle", 5000);
+	if ( break_count != 3 ) {
+		printf("  trigger short frame: %lu breaks\n", (unsigned long)break_count);
+		errors++;
+	}
+	if ( scheduler.triggeredFrames() != 3 ) {		// begin() counts as triggered
+		printf("  trigger short frame: %lu triggered frames\n", (unsigned long)scheduler.triggeredFrames());
+		errors++;
+	}
+	return errors;
+}
+
+// no triggers: one frame at begin, then one per keep alive interval
+static int test_idle_keep_alive ( void ) {
+	LXDMXFrameScheduler scheduler;
+	SimulatedUART uart(&scheduler, 512);
+	scheduler.setKeepAlive(50000);
+	simulate(&scheduler, &uart, NULL, 0, 260000);
+	int errors = 0;
+	uint32_t expect[] = { 0, 50000, 100000, 150000, 200000, 250000 };
+	if ( break_count != 6 ) {
+		printf("  keep alive: %lu breaks\n", (unsigned long)break_count);
+		errors++;
+	}
+	for (uint32_t i=0; i<6; i++) {
+		errors += expect_break("keep alive", expect[i]);
+	}
+	if ( scheduler.triggeredFrames() != 1 ) {
+		printf("  keep alive: %lu triggered frames\n", (unsigned long)scheduler.triggeredFrames());
+		errors++;
+	}
+	return errors;
+}
+
+// random triggers: minimum break to break is kept and every trigger is sent
+static int test_random_triggers ( uint16_t slots, uint32_t min, uint32_t mean_gap ) {
+	static uint32_t triggers[MAX_TRIGGERS];
+	LXDMXFrameScheduler scheduler;
+	SimulatedUART uart(&scheduler, slots);
+	scheduler.setMinBreakToBreak(min);
+	uint32_t t = 0;
+	uint32_t count = 0;
+	while ( count < MAX_TRIGGERS ) {
+		t += next_random() % ( 2 * mean_gap ) + 1;
+		triggers[count++] = t;
+	}
+	uint32_t end = t + 200000;
+	simulate(&scheduler, &uart, triggers, count, end);
+
+	if ( min < LXDMX_MIN_BREAK_TO_BREAK ) {
+		min = LXDMX_MIN_BREAK_TO_BREAK;				// as setMinBreakToBreak
+	}
+	int errors = check_min_break_to_break("random triggers", min);
+	uint32_t longest = min;						// a trigger is sent by the next frame allowed
+	if ( uart.frameTime() > longest ) {
+		longest = uart.frameTime();
+	}
+	uint32_t worst = 0;
+	for (uint32_t i=0; i<count; i++) {
+		uint32_t b = break_after(triggers[i]);		// triggers come before the break at the same time
+		if (( b == 0xffffffff ) || ( b - triggers[i] > longest + LOOP_PERIOD )) {
+			if ( errors < 5 ) {
+				printf("  random triggers: trigger at %lu sent at %lu\n", (unsigned long)triggers[i], (unsigned long)b);
+			}
+			errors++;
+		} else if ( b - triggers[i] > worst ) {
+			worst = b - triggers[i];
+		}
+	}
+	printf("  slots %3u min %5lu gap %5lu: %lu triggers, %lu frames, worst latency %lu us\n",
+			slots, (unsigned long)min, (unsigned long)mean_gap, (unsigned long)count,
+			(unsigned long)break_count, (unsigned long)worst);
+	return errors;
+}
+
+int main ( void ) {
+	int errors = 0;
+	printf("trigger\n");
+	errors += test_trigger_full_frames();
+	errors += test_trigger_short_frames();
+	printf("idle and keep alive\n");
+	errors += test_idle_keep_alive();
+	printf("minimum break to break\n");
+	errors += test_random_triggers(512, LXDMX_MIN_BREAK_TO_BREAK, 10000);
+	errors += test_random_triggers(512, LXDMX_MIN_BREAK_TO_BREAK, 500);
+	errors += test_random_triggers(24, LXDMX_MIN_BREAK_TO_BREAK, 800);
+	errors += test_random_triggers(8, 0, 300);				// clamped to LXDMX_MIN_BREAK_TO_BREAK
+	errors += test_random_triggers(64, 25000, 20000);
+	printf("%s\n", errors ? "FAIL" : "PASS");
+	return errors ? 1 : 0;
+}
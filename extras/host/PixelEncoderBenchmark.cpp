@@ -0,0 +1,116 @@
+/* PixelEncoderBenchmark.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   Host benchmark of LXPixelEncoder.  Also checks the SPI symbols against a
+   bit by bit reference and that capacities too large to encode are rejected
+   and that encode() on a rejected encoder writes nothing.
+
+   g++ -O2 -I../../src PixelEncoderBenchmark.cpp ../../src/LXPixelEncoder.cpp -o PixelEncoderBenchmark && ./PixelEncoderBenchmark
+
+   Rates are for the host CPU, not for a microcontroller.  Expect a small
+   fraction of them on a 32 bit board and much less on an AVR.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "LXPixelEncoder.h"
+
+#define BENCH_PIXELS 170				// one universe of RGB pixels
+#define BENCH_BYTES  ( BENCH_PIXELS * 3 )
+#define BENCH_FRAMES 200000
+
+static double seconds ( void ) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// one symbol per bit, high time from the bit
+static int check_symbols ( uint8_t mode, uint8_t bits ) {
+	uint8_t src[256];
+	uint8_t dst[256*4];
+	for (int i=0; i<256; i++) {
+		src[i] = i;
+	}
+	LXPixelEncoder::encodeBytes(mode, src, dst, 256);
+	for (int i=0; i<256; i++) {
+		for (int b=0; b<8; b++) {
+			uint32_t symbol = 0;
+			for (int k=0; k<bits; k++) {
+				uint32_t bit = ( i * 8 + b ) * bits + k;
+				symbol = ( symbol << 1 ) | (( dst[bit / 8] >> ( 7 - ( bit % 8 ))) & 1 );
+			}
+			uint32_t expect;
+			if ( bits == 4 ) {
+				expect = ( i & ( 0x80 >> b )) ? 0xe : 0x8;
+			} else {
+				expect = ( i & ( 0x80 >> b )) ? 0x6 : 0x4;
+			}
+			if ( symbol != expect ) {
+				printf("FAIL mode %u byte %d bit %d: %x\n", mode, i, b, (unsigned)symbol);
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+static int check_limits ( void ) {
+	int errors = 0;
+	LXPixelEncoder spi4_max(LXPIXEL_ENCODE_SPI4, 16377);
+	LXPixelEncoder spi4_over(LXPIXEL_ENCODE_SPI4, 16378);
+	LXPixelEncoder spi3_over(LXPIXEL_ENCODE_SPI3, 21838);
+	if ( spi4_max.capacity() != 16377 ) {
+		printf("FAIL SPI4 16377 bytes not accepted\n");
+		errors++;
+	}
+	if (( spi4_over.capacity() != 0 ) || ( spi3_over.capacity() != 0 )) {
+		printf("FAIL encoded size over 16 bits accepted\n");
+		errors++;
+	}
+	uint8_t pixels[3] = { 1, 2, 3 };
+	if (( spi4_over.encode(pixels, 3) != 0 ) || ( spi3_over.encode(pixels, 3) != 0 )) {
+		printf("FAIL rejected encoder encoded\n");
+		errors++;
+	}
+	spi4_over.swap();
+	if ( spi4_over.length() != 0 ) {
+		printf("FAIL rejected encoder has length\n");
+		errors++;
+	}
+	if ( LXPixelEncoder::encodedSize(LXPIXEL_ENCODE_SPI4, 0xFFFF) != 4UL * 0xFFFF + LXPIXEL_ENCODE_LATCH_BYTES ) {
+		printf("FAIL encodedSize wraps\n");
+		errors++;
+	}
+	return errors;
+}
+
+static void bench ( const char* name, uint8_t mode ) {
+	static uint8_t pixels[BENCH_BYTES];
+	LXPixelEncoder encoder(mode, BENCH_BYTES);
+	uint32_t sum = 0;
+	double start = seconds();
+	for (uint32_t f=0; f<BENCH_FRAMES; f++) {
+		pixels[f % BENCH_BYTES] = f;			// data changes each frame
+		encoder.encode(pixels, BENCH_BYTES);
+		encoder.swap();
+		sum += encoder.frontBuffer()[f % encoder.length()];
+	}
+	double elapsed = seconds() - start;
+	double mpixels = (double)BENCH_FRAMES * BENCH_PIXELS / elapsed / 1e6;
+	printf("  %-6s %8.1f Mpixel/s  %8.0f frames/s  (%u)\n", name, mpixels, BENCH_FRAMES / elapsed, (unsigned)( sum & 1 ));
+}
+
+int main ( void ) {
+	int errors = check_symbols(LXPIXEL_ENCODE_SPI4, 4);
+	errors += check_symbols(LXPIXEL_ENCODE_SPI3, 3);
+	errors += check_limits();
+	printf("%d RGB pixels, %d frames\n", BENCH_PIXELS, BENCH_FRAMES);
+	bench("bytes", LXPIXEL_ENCODE_BYTES);
+	bench("SPI3", LXPIXEL_ENCODE_SPI3);
+	bench("SPI4", LXPIXEL_ENCODE_SPI4);
+	printf("%s\n", errors ? "FAIL" : "PASS");
+	return errors ? 1 : 0;
+}
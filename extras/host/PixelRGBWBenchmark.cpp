@@ -0,0 +1,106 @@
+/* PixelRGBWBenchmark.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   Host benchmark of LXPixelRGBW, the same passes as the PixelRGBWBenchmark
+   example sketch.  Also checks convert() against a floating point reference.
+
+   g++ -O2 -I../../src PixelRGBWBenchmark.cpp ../../src/LXPixelRGBW.cpp ../../src/LXPixelOrder.cpp -o PixelRGBWBenchmark && ./PixelRGBWBenchmark
+
+   Rates are for the host CPU, not for a microcontroller.
+*/
+
+#include <stdio.h>
+#include <time.h>
+#include "LXPixelRGBW.h"
+
+#define BENCH_PIXELS 170				// one universe of RGB pixels
+#define BENCH_PASSES 200000
+
+static uint8_t rgb[BENCH_PIXELS * 3];
+static uint8_t rgbw[BENCH_PIXELS * 4];
+
+static double seconds ( void ) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// every RGB level in steps of 5, output within 2 of the exact value
+// (white is rounded down so red, green and blue may keep up to 2 more than exact)
+static int check ( const char* name, LXPixelRGBW* converter, const double wp[3], const double balance[4] ) {
+	uint8_t in[3];
+	uint8_t out[4];
+	int errors = 0;
+	for (int r=0; r<256; r+=5) {
+		for (int g=0; g<256; g+=5) {
+			for (int b=0; b<256; b+=5) {
+				in[0] = r;
+				in[1] = g;
+				in[2] = b;
+				converter->convert(in, out, 1);			// GRBW
+				double w = r / wp[0];
+				if ( g / wp[1] < w ) w = g / wp[1];
+				if ( b / wp[2] < w ) w = b / wp[2];
+				if ( w > 255 ) w = 255;
+				double expect[4] = { ( r - w * wp[0] ) * balance[0], ( g - w * wp[1] ) * balance[1],
+									 ( b - w * wp[2] ) * balance[2], w * balance[3] };
+				uint8_t got[4] = { out[1], out[0], out[2], out[3] };
+				for (int c=0; c<4; c++) {
+					double d = got[c] - expect[c];
+					if (( d > 2.0 ) || ( d < -2.0 )) {
+						if ( errors < 5 ) {
+							printf("  %s %d,%d,%d channel %d: %u expected %.2f\n", name, r, g, b, c, got[c], expect[c]);
+						}
+						errors++;
+					}
+				}
+			}
+		}
+	}
+	return errors;
+}
+
+static void bench ( const char* name, LXPixelRGBW* converter ) {
+	uint32_t sum = 0;
+	double start = seconds();
+	for (uint32_t n=0; n<BENCH_PASSES; n++) {
+		rgb[0] = n;								// data changes each pass
+		converter->convert(rgb, rgbw, BENCH_PIXELS);
+		sum += rgbw[n % sizeof(rgbw)];
+	}
+	double elapsed = seconds() - start;
+	printf("  %-22s %8.1f Mpixel/s  (%u)\n", name, (double)BENCH_PIXELS * BENCH_PASSES / elapsed / 1e6, (unsigned)( sum & 1 ));
+}
+
+int main ( void ) {
+	uint32_t seed = 12345;
+	for (int i=0; i<BENCH_PIXELS * 3; i++) {
+		seed = seed * 1103515245 + 12345;
+		rgb[i] = seed >> 16;
+	}
+
+	LXPixelRGBW converter(LXPIXEL_ORDER_GRBW);
+	double unity[3] = { 1.0, 1.0, 1.0 };
+	double warm[3] = { 256 / 256.0, 200 / 256.0, 150 / 256.0 };
+	double full[4] = { 1.0, 1.0, 1.0, 1.0 };
+	double balance[4] = { 256 / 256.0, 240 / 256.0, 220 / 256.0, 256 / 256.0 };
+	int errors = 0;
+
+	printf("%d RGB pixels, %d passes\n", BENCH_PIXELS, BENCH_PASSES);
+	converter.setMode(LXPIXEL_WHITE_MIN);
+	errors += check("min", &converter, unity, full);
+	bench("min", &converter);
+
+	converter.setMode(LXPIXEL_WHITE_CALIBRATED);
+	converter.setWhitePoint(256, 200, 150);		// warm white
+	errors += check("calibrated", &converter, warm, full);
+	bench("calibrated", &converter);
+
+	converter.setBalance(256, 240, 220, 256);
+	errors += check("calibrated + balance", &converter, warm, balance);
+	bench("calibrated + balance", &converter);
+
+	printf("%s\n", errors ? "FAIL" : "PASS");
+	return errors ? 1 : 0;
+}
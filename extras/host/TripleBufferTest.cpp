@@ -0,0 +1,121 @@
+/* TripleBufferTest.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   Host test of the LXDMXTripleBuffer handoff with a simulated ISR.
+
+   g++ -O2 -I../../src TripleBufferTest.cpp -o TripleBufferTest && ./TripleBufferTest
+
+   The producer fills every slot of a frame with a sequence number, one slot
+   per step, and publishes it.  The consumer acquires at each start code and
+   reads one slot per step.  A pseudo random schedule interleaves the two at
+   slot granularity, as an ISR would preempt the loop.  Every frame read must
+   hold a single sequence number (no tearing) and sequence numbers must never
+   go backwards.  This is run for output (loop produces, ISR consumes) and for
+   input (ISR produces, loop consumes), and with buffering disabled to check
+   the single frame path is unchanged.
+*/
+
+#include <stdio.h>
+#include "LXDMXTripleBuffer.h"
+
+static uint32_t rng_state = 12345;
+
+static uint32_t next_random ( void ) {		// xorshift32
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= rng_state << 5;
+	return rng_state;
+}
+
+// producer_weight of 256 steps go to the producer
+static int run ( uint32_t producer_weight, uint16_t slots, uint32_t steps ) {
+	LXDMXTripleBuffer buffer;
+	if ( ! buffer.setEnabled(1) ) {
+		printf("FAIL could not enable buffering\n");
+		return 1;
+	}
+
+	uint8_t  seq = 1;
+	uint16_t write_slot = 0;
+	uint16_t read_slot = 0;
+	uint8_t  frame_value = 0;
+	uint8_t  last_value = 0;
+	uint32_t frames_read = 0;
+	uint32_t published = 0;
+	int      errors = 0;
+
+	for ( uint32_t i=0; i<steps; i++ ) {
+		if (( next_random() & 0xff ) < producer_weight ) {
+			buffer.writeFrame()[write_slot++] = seq;
+			if ( write_slot > slots ) {
+				buffer.publish(0);
+				published++;
+				seq = ( seq == 255 ) ? 1 : seq + 1;
+				write_slot = 0;
+			}
+		} else {
+			if ( read_slot == 0 ) {
+				buffer.acquire();
+				frame_value = buffer.readFrame()[0];
+			}
+			if ( buffer.readFrame()[read_slot] != frame_value ) {
+				if ( errors < 5 ) {
+					printf("  torn frame %lu slot %u: %u != %u\n", (unsigned long)frames_read,
+							read_slot, buffer.readFrame()[read_slot], frame_value);
+				}
+				errors++;
+			}
+			read_slot++;
+			if ( read_slot > slots ) {
+				if ( frame_value != 0 ) {
+					uint8_t behind = (uint8_t)( last_value - frame_value );
+					if (( last_value != 0 ) && ( behind != 0 ) && ( behind < 128 )) {
+						printf("  frame %u after %u\n", frame_value, last_value);
+						errors++;
+					}
+					last_value = frame_value;
+				}
+				frames_read++;
+				read_slot = 0;
+			}
+		}
+	}
+	printf("  producer %3lu/256 slots %3u: %lu published, %lu read, %d errors\n",
+			(unsigned long)producer_weight, slots, (unsigned long)published,
+			(unsigned long)frames_read, errors);
+	return errors;
+}
+
+static int run_single_frame ( void ) {
+	LXDMXTripleBuffer buffer;
+	buffer.setEnabled(0);
+	buffer.writeFrame()[1] = 42;
+	buffer.publish(1);
+	if (( buffer.readFrame() != buffer.writeFrame() ) || ( buffer.readFrame()[1] != 42 ) || buffer.acquire() ) {
+		printf("FAIL single frame\n");
+		return 1;
+	}
+	if ( buffer.setEnabled(1) && ( buffer.readFrame()[1] != 42 )) {	// enabling keeps current data
+		printf("FAIL enable copies frame\n");
+		return 1;
+	}
+	buffer.setEnabled(0);
+	if ( buffer.readFrame() != buffer.writeFrame() ) {
+		printf("FAIL disable\n");
+		return 1;
+	}
+	return 0;
+}
+
+int main ( void ) {
+	int errors = run_single_frame();
+	printf("output, loop produces faster than ISR consumes\n");
+	errors += run(192, 512, 5000000);
+	printf("output, loop produces slower\n");
+	errors += run(32, 512, 5000000);
+	printf("input, ISR produces short frames\n");
+	errors += run(128, 24, 5000000);
+	printf("%s\n", errors ? "FAIL" : "PASS");
+	return errors ? 1 : 0;
+}
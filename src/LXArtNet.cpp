@@ -24,20 +24,30 @@ uint8_t LXArtNet::_reply_buffer[ARTNET_REPLY_SIZE];
 
 LXArtNet::LXArtNet ( IPAddress address )
 {
-	initialize(0);
+	initialize((uint8_t*) malloc(ARTNET_BUFFER_MAX), 1);
 	setLocalIP( address );
     _broadcast_address = INADDR_NONE;
 }
 
 LXArtNet::LXArtNet ( IPAddress address, IPAddress subnet_mask )
 {
-	initialize(0);
+	initialize((uint8_t*) malloc(ARTNET_BUFFER_MAX), 1);
 	setLocalIP( address, subnet_mask );
 }
 
 LXArtNet::LXArtNet ( IPAddress address, IPAddress subnet_mask, uint8_t* buffer )
 {
-	initialize(buffer);
+	initialize(buffer, 0);
+	setLocalIP( address, subnet_mask );
+	
+    uint32_t a = (uint32_t) address;
+    uint32_t s = (uint32_t) subnet_mask;
+    _broadcast_address = IPAddress(a | ~s);
+}
+
+LXArtNet::LXArtNet ( IPAddress address, IPAddress subnet_mask, LXDMXArena* arena )
+{
+	initialize(arena->allocate(ARTNET_BUFFER_MAX), 0);
 	setLocalIP( address, subnet_mask );
 	
     uint32_t a = (uint32_t) address;
@@ -50,27 +60,26 @@ LXArtNet::~LXArtNet ( void )
    if ( _owns_buffer ) {		// if we created this buffer, then free the memory
 		free(_packet_buffer);
 	}
-	if ( _using_htp ) {
+	if ( _owns_htp_buffers ) {
 		free(_dmx_buffer_a);
 		free(_dmx_buffer_b);
 		free(_dmx_buffer_c);
 	}
 }
 
-void  LXArtNet::initialize  ( uint8_t* b ) {
-	if ( b == 0 ) {
-		// create buffer
-		_packet_buffer = (uint8_t*) malloc(ARTNET_BUFFER_MAX);
-		_owns_buffer = 1;
-	} else {
-		// external buffer.  Size MUST be >=ARTNET_BUFFER_MAX
-		_packet_buffer = b;
-		_owns_buffer = 0;
-	}
+void  LXArtNet::initialize  ( uint8_t* b, uint8_t owns ) {
+	// allocated by constructor or external buffer.  Size MUST be >=ARTNET_BUFFER_MAX
+	_packet_buffer = b;
+	_owns_buffer = owns;
 	
-    memset(_packet_buffer, 0, ARTNET_BUFFER_MAX);
+	if ( _packet_buffer != NULL ) {		// NULL if malloc or arena failed
+		memset(_packet_buffer, 0, ARTNET_BUFFER_MAX);
+	}
     
     _using_htp    = 0;
+    _owns_htp_buffers = 0;
+    _htp_size     = DMX_UNIVERSE_SIZE;
+    _window_first = 0;
     _dmx_buffer_a = 0;
     _dmx_buffer_b = 0;
     _dmx_buffer_c = 0;
@@ -81,15 +90,32 @@ void  LXArtNet::initialize  ( uint8_t* b ) {
     _universe    = 0;
     _net         = 0;
     _sequence    = 1;
+    _dmx_received_time = 0;
+    _latency_monitor = 0;
+    _dmx_received_callback = 0;
+    _universe_store = 0;
+    _store_index = 0;
+    _changed_first = 0;
+    _changed_last = 0;
     
      _dmx_sender = INADDR_NONE;
      _dmx_sender_b = INADDR_NONE;
+     
+    _last_dmx_time = 0;
+    _last_dmx_time_b = 0;
+    _poll_reply_count = 0;
+    
+    _poll_reply_max_delay = 0;
+    _poll_reply_pending = 0;
+    _poll_reply_due = 0;
+    _poll_reply_random = 1;
     
     initializePollReply();
     
     _art_tod_req_callback = 0;
     _art_rdm_callback = 0;
     _art_cmd_callback = 0;
+    _rdm_queue = 0;
 }
 
 
@@ -127,8 +153,13 @@ void LXArtNet::setNetAddress ( uint8_t s ) {
 	}
 }
 
+uint8_t LXArtNet::net ( void ) {
+	return _net;
+}
+
 void LXArtNet::setLocalIP ( IPAddress a ) {
 	_my_address = a;
+	_poll_reply_random = ((uint32_t)a >> 16) | 1;	// host part of address, never zero
 	_reply_buffer[10] = ((uint32_t)_my_address) & 0xff;      //ip address
   	_reply_buffer[11] = ((uint32_t)_my_address) >> 8;
   	_reply_buffer[12] = ((uint32_t)_my_address) >> 16;
@@ -148,10 +179,18 @@ void LXArtNet::enableHTP() {
 	// not enough memory on these to allocate these buffers
 #else
 	if ( ! _using_htp ) {
-		_dmx_buffer_a = (uint8_t*) malloc(DMX_UNIVERSE_SIZE);
-		_dmx_buffer_b = (uint8_t*) malloc(DMX_UNIVERSE_SIZE);
-		_dmx_buffer_c = (uint8_t*) malloc(DMX_UNIVERSE_SIZE);
-		for(int i=0; i<DMX_UNIVERSE_SIZE; i++) {
+		// buffers hold the slot window, all 512 slots unless setSlotWindow was called
+		_dmx_buffer_a = (uint8_t*) malloc(_htp_size);
+		_dmx_buffer_b = (uint8_t*) malloc(_htp_size);
+		_dmx_buffer_c = (uint8_t*) malloc(_htp_size);
+		if (( _dmx_buffer_a == NULL ) || ( _dmx_buffer_b == NULL ) || ( _dmx_buffer_c == NULL )) {
+			free(_dmx_buffer_a);	// free(NULL) does nothing
+			free(_dmx_buffer_b);
+			free(_dmx_buffer_c);
+			return;
+		}
+		_owns_htp_buffers = 1;
+		for(int i=0; i<_htp_size; i++) {
 		   _dmx_buffer_a[i] = 0;
 		   _dmx_buffer_b[i] = 0;
 		   _dmx_buffer_c[i] = 0;
@@ -161,6 +200,56 @@ void LXArtNet::enableHTP() {
 #endif
 }
 
+uint8_t LXArtNet::enableHTP( LXDMXArena* arena ) {
+	if ( ! _using_htp ) {
+		if ( arena->remaining() < (size_t)( 3 * LXDMX_ARENA_ALIGNED(_htp_size) )) {
+			return 0;
+		}
+		_dmx_buffer_a = arena->allocate(_htp_size);
+		_dmx_buffer_b = arena->allocate(_htp_size);
+		_dmx_buffer_c = arena->allocate(_htp_size);
+		memset(_dmx_buffer_a, 0, _htp_size);
+		memset(_dmx_buffer_b, 0, _htp_size);
+		memset(_dmx_buffer_c, 0, _htp_size);
+		_using_htp = 1;
+	}
+	return 1;
+}
+
+uint8_t LXArtNet::enableLowMemoryHTP( uint16_t slots ) {
+	if ( ! _using_htp ) {
+		if (( slots == 0 ) || ( slots > _htp_size )) {
+			slots = _htp_size;
+		}
+		_dmx_buffer_a = (uint8_t*) malloc(slots);
+		_dmx_buffer_b = (uint8_t*) malloc(slots);
+		if (( _dmx_buffer_a == NULL ) || ( _dmx_buffer_b == NULL )) {
+			free(_dmx_buffer_a);
+			free(_dmx_buffer_b);
+			return 0;
+		}
+		_dmx_buffer_c = NULL;					// merged data is written back to the packet buffer
+		memset(_dmx_buffer_a, 0, slots);
+		memset(_dmx_buffer_b, 0, slots);
+		_owns_htp_buffers = 1;
+		_htp_size = slots;
+		_using_htp = 1;
+	}
+	return 1;
+}
+
+uint8_t LXArtNet::setSlotWindow( uint16_t start, uint16_t len ) {
+	if ( _using_htp || ( start < 1 ) || ( start > DMX_UNIVERSE_SIZE ) || ( len == 0 )) {
+		return 0;
+	}
+	if ( len > DMX_UNIVERSE_SIZE + 1 - start ) {
+		len = DMX_UNIVERSE_SIZE + 1 - start;
+	}
+	_window_first = start - 1;
+	_htp_size = len;
+	return 1;
+}
+
 int  LXArtNet::numberOfSlots ( void ) {
 	return _dmx_slots;
 }
@@ -170,18 +259,63 @@ void LXArtNet::setNumberOfSlots ( int n ) {
 }
 
 uint8_t LXArtNet::getSlot ( int slot ) {
+	if ( _packet_buffer == NULL ) {
+		return 0;
+	}
 	return _packet_buffer[ARTNET_ADDRESS_OFFSET+slot];
 }
 
 uint8_t LXArtNet::getHTPSlot ( int slot ) {
-	return _dmx_buffer_c[slot-1];
+	uint16_t i = slot - 1 - _window_first;		// index in slot window
+	if ( i < _htp_size ) {
+		if ( _dmx_buffer_c != NULL ) {
+			return _dmx_buffer_c[i];
+		}
+		uint8_t a = _dmx_buffer_a[i];				// low memory HTP, merge on demand
+		uint8_t b = _dmx_buffer_b[i];
+		return ( a > b ) ? a : b;
+	}
+	return 0;
 }
 
 void LXArtNet::setSlot ( int slot, uint8_t value ) {
-	_packet_buffer[ARTNET_ADDRESS_OFFSET+slot] = value;
+	if ( _packet_buffer != NULL ) {
+		_packet_buffer[ARTNET_ADDRESS_OFFSET+slot] = value;
+	}
+}
+
+void LXArtNet::getSlots ( int start, int count, uint8_t* dst ) {
+	count = slotRangeCount(start, count);
+	if ( count && ( _packet_buffer != NULL )) {
+		memcpy(dst, &_packet_buffer[ARTNET_ADDRESS_OFFSET+start], count);
+	}
+}
+
+void LXArtNet::setSlots ( int start, int count, const uint8_t* src ) {
+	count = slotRangeCount(start, count);
+	if ( count && ( _packet_buffer != NULL )) {
+		memcpy(&_packet_buffer[ARTNET_ADDRESS_OFFSET+start], src, count);
+	}
+}
+
+LXDMXSpan LXArtNet::universeSpan ( void ) {
+	LXDMXSpan span;
+	if ( _packet_buffer == NULL ) {
+		span.slots = NULL;
+		span.count = 0;
+		span.start = 0;
+		return span;
+	}
+	span.slots = window_data();
+	span.count = window_slots();
+	span.start = _window_first + 1;
+	return span;
 }
 
 uint8_t* LXArtNet::dmxData( void ) {
+	if ( _packet_buffer == NULL ) {
+		return NULL;
+	}
 	return &_packet_buffer[ARTNET_ADDRESS_OFFSET+1];
 }
 
@@ -211,7 +345,7 @@ uint8_t LXArtNet::readDMXPacket ( UDP* eUDP ) {
 }
 
 uint8_t LXArtNet::readDMXPacketContents ( UDP* eUDP, int packetSize ) {
-	if ( packetSize > 0 ) {
+	if (( packetSize > 0 ) && ( _packet_buffer != NULL )) {
 		uint16_t opcode = readArtNetPacketContents(eUDP, packetSize);
 		if ( opcode == ARTNET_ART_DMX ) {
 			return RESULT_DMX_RECEIVED;
@@ -233,15 +367,31 @@ uint8_t LXArtNet::readDMXPacketContents ( UDP* eUDP, int packetSize ) {
 */
 uint16_t LXArtNet::readArtNetPacket ( UDP* eUDP ) {
 	uint16_t opcode = ARTNET_NOP;
+	sendPendingPollReply(eUDP);
 	int packetSize = eUDP->parsePacket();
-	if ( packetSize > 0 ) {
-		packetSize = eUDP->read(_packet_buffer, ARTNET_BUFFER_MAX);
+	if (( packetSize > 0 ) && ( _packet_buffer != NULL )) {
+		packetSize = eUDP->read(_packet_buffer, ARTNET_HEADER_PEEK);
+		if ( packetSize == ARTNET_HEADER_PEEK ) {
+			if ( other_universe() ) {
+				// data is left unread, parsePacket() discards it
+				_counters.countPacket(ARTNET_COUNT_DMX);
+				_counters.countRejected(LXDMX_REJECT_WRONG_UNIVERSE);
+				return ARTNET_NOP;
+			}
+			int rest = eUDP->read(&_packet_buffer[ARTNET_HEADER_PEEK], ARTNET_BUFFER_MAX - ARTNET_HEADER_PEEK);
+			if ( rest > 0 ) {
+				packetSize += rest;
+			}
+		}
 		opcode = readArtNetPacketContents(eUDP, packetSize);
 	}
 	return opcode;
 }
 
 uint16_t LXArtNet::readArtNetPacketContents ( UDP* eUDP, int packetSize ) {
+	if ( _packet_buffer == NULL ) {
+		return ARTNET_NOP;
+	}
    if ( ! _using_htp ) {
 		_dmx_slots = 0;
 		/* Buffer now may not contain dmx data for desired universe.
@@ -251,6 +401,7 @@ uint16_t LXArtNet::readArtNetPacketContents ( UDP* eUDP, int packetSize ) {
 	}
 	
 	uint16_t opcode = parse_header();
+	_counters.countPacket(counter_index(opcode));
 	switch ( opcode ) {
 		case ARTNET_ART_DMX:
 		   opcode = ARTNET_NOP;
@@ -262,19 +413,25 @@ uint16_t LXArtNet::readArtNetPacketContents ( UDP* eUDP, int packetSize ) {
 					slots += _packet_buffer[16] << 8;
 					if ( packetSize >= slots ) {					// double check we got all expected
 						opcode = readArtDMX(eUDP, slots, packetSize);      // returns ARTNET_ART_DMX
+					} else {
+						_counters.countRejected(LXDMX_REJECT_SHORT_PACKET);
 					}
-				}		// matched universe/net
+				} else {	// matched universe/net
+					_counters.countRejected(LXDMX_REJECT_WRONG_UNIVERSE);
+				}
 			}			// can output from network
 			break;
 		case ARTNET_ART_ADDRESS:
 			if (( packetSize >= 107 ) && ( _packet_buffer[11] >= 14 )) {  //protocol version [10] hi byte [11] lo byte
 				opcode = parse_art_address( eUDP );
-				send_art_poll_reply( eUDP );
+				schedule_poll_reply( eUDP );
 			}
 			break;
 		case ARTNET_ART_POLL:
 			if (( packetSize >= 14 ) && ( _packet_buffer[11] >= 14 )) {
-				send_art_poll_reply( eUDP );
+				if ( pollTargetsThisNode(packetSize) ) {
+					schedule_poll_reply( eUDP );
+				}
 			}
 			break;
 		case ARTNET_ART_TOD_REQUEST:
@@ -292,7 +449,7 @@ uint16_t LXArtNet::readArtNetPacketContents ( UDP* eUDP, int packetSize ) {
 		case ARTNET_ART_RDM:
 		   opcode = ARTNET_NOP;
 		   if (( packetSize >= 24 ) && ( _packet_buffer[11] >= 14 )) {
-				opcode = parse_art_rdm( eUDP );
+				opcode = parse_art_rdm( eUDP, packetSize );
 			}
 			break;
 		case ARTNET_ART_CMD:
@@ -307,10 +464,12 @@ uint16_t LXArtNet::readArtNetPacketContents ( UDP* eUDP, int packetSize ) {
 
 uint16_t LXArtNet::readArtDMX ( UDP* eUDP, uint16_t slots, int packetSize ) {
 	uint16_t opcode = ARTNET_NOP;
+	_changed_first = 0;
+	_changed_last = 0;
 	if ( _using_htp ) {
 	   if ( (uint32_t)_dmx_sender == 0 ) {		//if first sender, remember address
 			_dmx_sender = eUDP->remoteIP();
-			for(int j=0; j<DMX_UNIVERSE_SIZE; j++) {
+			for(int j=0; j<_htp_size; j++) {
 				_dmx_buffer_b[j] = 0;	//insure clear buffer 'b' so cancel merge works properly
 			}
 	   }
@@ -321,21 +480,30 @@ uint16_t LXArtNet::readArtDMX ( UDP* eUDP, uint16_t slots, int packetSize ) {
 			} else {
 				_dmx_slots = _dmx_slots_b;
 			}
+			if ( _dmx_slots > _window_first + _htp_size ) {					// slots beyond window are not kept
+				_dmx_slots = _window_first + _htp_size;
+			}
 			uint16_t di;
 			uint16_t dc = _dmx_slots;
 			uint16_t dt = ARTNET_ADDRESS_OFFSET + 1;
-			  for (di=0; di<dc; di++) {
+			  for (di=_window_first; di<dc; di++) {
+				uint16_t bi = di - _window_first;		// index in window buffers
 				if ( di < slots ) {								// total slots may be greater than slots in this packet
-					_dmx_buffer_a[di] = _packet_buffer[dt+di];
+					_dmx_buffer_a[bi] = _packet_buffer[dt+di];
 				}  else {										// don't read beyond end of received slots
-					_dmx_buffer_a[di] = 0;						// set remainder to zero	
+					_dmx_buffer_a[bi] = 0;						// set remainder to zero	
 				}
-				if ( _dmx_buffer_a[di] > _dmx_buffer_b[di] ) {
-					_dmx_buffer_c[di] = _dmx_buffer_a[di];
+				if ( _dmx_buffer_a[bi] > _dmx_buffer_b[bi] ) {
+					set_merged_slot(di, _dmx_buffer_a[bi]);
 				} else {
-					_dmx_buffer_c[di] = _dmx_buffer_b[di]; 
+					set_merged_slot(di, _dmx_buffer_b[bi]);
 				}
 			}
+			_counters.countAccepted(0);
+			_last_dmx_time = millis();
+			if ( (uint32_t)_dmx_sender_b != 0 ) {
+				_counters.countMerge();
+			}
 			opcode = ARTNET_ART_DMX;
 		} else { 												// did not match sender a
 			if ( (uint32_t)_dmx_sender_b == 0 ) {		// if 2nd sender, remember address
@@ -348,22 +516,32 @@ uint16_t LXArtNet::readArtDMX ( UDP* eUDP, uint16_t slots, int packetSize ) {
 				} else {
 					_dmx_slots = _dmx_slots_b;
 				}
+				if ( _dmx_slots > _window_first + _htp_size ) {
+					_dmx_slots = _window_first + _htp_size;
+				}
 			  uint16_t di;
 			  uint16_t dc = _dmx_slots;
 			  uint16_t dt = ARTNET_ADDRESS_OFFSET + 1;
-			  for (di=0; di<dc; di++) {
+			  for (di=_window_first; di<dc; di++) {
+				uint16_t bi = di - _window_first;		// index in window buffers
 				if ( di < slots ) {								//total slots may be greater than slots in this packet				
-					_dmx_buffer_b[di] = _packet_buffer[dt+di];
+					_dmx_buffer_b[bi] = _packet_buffer[dt+di];
 				}  else {											//don't read beyond end of received slots	
-					_dmx_buffer_b[di] = 0;							//set remainder to zero	
+					_dmx_buffer_b[bi] = 0;							//set remainder to zero	
 				}
-				if ( _dmx_buffer_a[di] > _dmx_buffer_b[di] ) {
-					_dmx_buffer_c[di] = _dmx_buffer_a[di];
+				if ( _dmx_buffer_a[bi] > _dmx_buffer_b[bi] ) {
+					set_merged_slot(di, _dmx_buffer_a[bi]);
 				} else {
-					_dmx_buffer_c[di] = _dmx_buffer_b[di];
+					set_merged_slot(di, _dmx_buffer_b[bi]);
 				}
 			  }
+			  _counters.countAccepted(1);
+			  _counters.countMerge();
+			  _last_dmx_time = millis();
+			  _last_dmx_time_b = _last_dmx_time;
 			  opcode = ARTNET_ART_DMX;
+			} else {
+			  _counters.countRejected(LXDMX_REJECT_WRONG_SENDER);
 			}  // matched sender b
 		}     // did not match sender a
 	} else {								    // NOTE _using_htp only allow one sender
@@ -374,19 +552,88 @@ uint16_t LXArtNet::readArtDMX ( UDP* eUDP, uint16_t slots, int packetSize ) {
 		if ( _dmx_sender == eUDP->remoteIP() ) {
 #endif
 			_dmx_slots = slots;
-			//zero remainder of buffer
-		   for (int n=packetSize+18; n<ARTNET_BUFFER_MAX; n++) {
+			//zero remainder of buffer, only to the end of the slot window
+		   int n = packetSize+18;
+		   if ( n < 18 + _window_first ) {
+			  n = 18 + _window_first;
+		   }
+		   for ( ; n<18+_window_first+_htp_size; n++) {
 			  _packet_buffer[n] = 0;
 		    }
+		  _counters.countAccepted(0);
+		  _last_dmx_time = millis();
 		  opcode = ARTNET_ART_DMX;
 #if defined ( NO_HTP_IS_SINGLE_SENDER )
+		} else {
+		  _counters.countRejected(LXDMX_REJECT_WRONG_SENDER);
 		}	// matched sender
 #endif
 	}
+	if ( opcode == ARTNET_ART_DMX ) {
+		_dmx_received_time = micros();
+		if ( _latency_monitor != NULL ) {
+			_latency_monitor->packetReceived(_dmx_received_time);
+		}
+		dmx_received();
+	}
 	return opcode;
 }
 
+void LXArtNet::set_merged_slot ( uint16_t di, uint8_t value ) {
+	if ( _dmx_buffer_c == NULL ) {
+		// low memory HTP: previous merge is not kept, every slot is reported as changed
+		_packet_buffer[ARTNET_ADDRESS_OFFSET+1+di] = value;
+		if ( _changed_first == 0 ) {
+			_changed_first = di + 1;
+		}
+		_changed_last = di + 1;
+	} else if ( _dmx_buffer_c[di-_window_first] != value ) {
+		_dmx_buffer_c[di-_window_first] = value;
+		if ( _changed_first == 0 ) {
+			_changed_first = di + 1;
+		}
+		_changed_last = di + 1;		// slots are merged in ascending order
+	}
+}
+
+uint8_t* LXArtNet::window_data ( void ) {
+	if ( _using_htp && ( _dmx_buffer_c != NULL )) {
+		return _dmx_buffer_c;
+	}
+	return &_packet_buffer[ARTNET_ADDRESS_OFFSET+1+_window_first];
+}
+
+uint16_t LXArtNet::window_slots ( void ) {
+	if ( _dmx_slots <= _window_first ) {
+		return 0;
+	}
+	if ( _dmx_slots - _window_first > _htp_size ) {
+		return _htp_size;
+	}
+	return _dmx_slots - _window_first;
+}
+
+void LXArtNet::dmx_received ( void ) {
+	if ( _universe_store != NULL ) {
+		_universe_store->update(_store_index, LXDMX_SOURCE_ARTNET, window_data(), window_slots(), 0);
+	}
+	if ( _dmx_received_callback != NULL ) {
+		uint16_t port_address = ( _net << 8 ) | _universe;
+		uint16_t count = window_slots();
+		if ( _using_htp ) {
+			_dmx_received_callback(port_address, window_data(), count, _changed_first, _changed_last);
+		} else if ( count ) {
+			_dmx_received_callback(port_address, window_data(), count, _window_first + 1, _window_first + count);
+		} else {
+			_dmx_received_callback(port_address, window_data(), 0, 0, 0);
+		}
+	}
+}
+
 void LXArtNet::sendDMX ( UDP* eUDP, IPAddress to_ip ) {
+   if ( _packet_buffer == NULL ) {
+      return;
+   }
    strcpy((char*)_packet_buffer, "Art-Net");
    if ( _dmx_slots > 0 ) {
 	   _packet_buffer[8] = 0;        //op code lo-hi
@@ -409,6 +656,7 @@ void LXArtNet::sendDMX ( UDP* eUDP, IPAddress to_ip ) {
 	   eUDP->beginPacket(to_ip, ARTNET_PORT);
 	   eUDP->write(_packet_buffer, 18+_dmx_slots);
 	   eUDP->endPacket();
+	   _last_dmx_time = millis();
    }
 }
 
@@ -445,17 +693,149 @@ void LXArtNet::send_art_poll( UDP* eUDP ) {
   includes my_ip as address of this node
 */
 void LXArtNet::send_art_poll_reply( UDP* eUDP ) {
-	_reply_buffer[18]  = _net;
-	_reply_buffer[19]  = (_universe >> 4) & 0x0f;
-	_reply_buffer[190] = _universe & 0x0f;
-  
   IPAddress a = _broadcast_address;
   if ( a == INADDR_NONE ) {
     a = eUDP->remoteIP();   // reply directly if no broadcast address is supplied
   }
-  eUDP->beginPacket(a, ARTNET_PORT);
-  eUDP->write(_reply_buffer, ARTNET_REPLY_SIZE);
-  eUDP->endPacket();
+  send_poll_reply_to(eUDP, a);
+}
+
+void LXArtNet::send_poll_reply_to( UDP* wUDP, IPAddress a ) {
+	_reply_buffer[18]  = _net;
+	_reply_buffer[19]  = (_universe >> 4) & 0x0f;
+	_reply_buffer[190] = _universe & 0x0f;
+	update_poll_reply_status();
+	
+	wUDP->beginPacket(a, ARTNET_PORT);
+	wUDP->write(_reply_buffer, ARTNET_REPLY_SIZE);
+	wUDP->endPacket();
+}
+
+/*
+  GoodOutput [182] bit 7 data transmitted, bit 3 merging, bit 1 merge mode LTP (clear, always HTP)
+  GoodInput  [178] bit 7 data received, bit 3 input disabled
+  NodeReport [108] "#xxxx [yyyy] zzzz" status code, reply count, text
+*/
+void LXArtNet::update_poll_reply_status( void ) {
+	unsigned long now = millis();
+	uint8_t active = ( _last_dmx_time != 0 ) && (( now - _last_dmx_time ) < ARTNET_DATA_TIMEOUT );
+	
+	if ( _reply_buffer[174] & 0x80 ) {		// output from network
+		uint8_t good = 0;
+		if ( active ) {
+			good = 0x80;
+			if ( _using_htp && ((uint32_t)_dmx_sender_b != 0) ) {
+				if (( now - _last_dmx_time_b ) < ARTNET_DATA_TIMEOUT ) {
+					good |= 0x08;
+				}
+			}
+		}
+		_reply_buffer[182] = good;
+		_reply_buffer[178] = 0x08;
+	} else {									// input to network
+		_reply_buffer[182] = 0x00;
+		_reply_buffer[178] = active ? 0x80 : 0x00;
+	}
+	
+	_poll_reply_count++;
+	if ( _poll_reply_count > 9999 ) {
+		_poll_reply_count = 0;
+	}
+	// "#0001 [count] OK|No data n DMX packets", at most 43 characters
+	// formatted by hand, printf would add its formatter to the sketch
+	char* p = (char*)&_reply_buffer[ARTNET_NODE_REPORT_OFFSET];
+	strcpy(p, "#0001 [");
+	p = append_decimal(p + 7, _poll_reply_count, 4);
+	strcpy(p, active ? "] OK " : "] No data ");
+	p = append_decimal(p + strlen(p), _counters.accepted(), 1);
+	strcpy(p, " DMX packets");
+}
+
+/*
+  writes value in decimal with at least digits digits, zero padded
+  returns the end of the string (the terminating zero)
+*/
+char* LXArtNet::append_decimal( char* p, uint32_t value, uint8_t digits ) {
+	char reversed[10];
+	uint8_t n = 0;
+	do {
+		reversed[n++] = '0' + ( value % 10 );
+		value /= 10;
+	} while ( value != 0 );
+	while ( n < digits ) {
+		reversed[n++] = '0';
+	}
+	while ( n > 0 ) {
+		*p++ = reversed[--n];
+	}
+	*p = 0;
+	return p;
+}
+
+void LXArtNet::setPollReplyDelay( uint16_t max_ms ) {
+	_poll_reply_max_delay = max_ms;
+}
+
+uint8_t LXArtNet::sendPendingPollReply( UDP* eUDP ) {
+	if ( _poll_reply_pending ) {
+		if ( (long)(millis() - _poll_reply_due) >= 0 ) {
+			_poll_reply_pending = 0;
+			send_poll_reply_to(eUDP, _poll_reply_address);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+  replies immediately unless a delay is set
+  a reply already pending to the same address answers this poll too
+  (always the case when replies are broadcast)
+*/
+void LXArtNet::schedule_poll_reply( UDP* wUDP ) {
+	if ( _poll_reply_max_delay == 0 ) {
+		send_art_poll_reply( wUDP );
+		return;
+	}
+	
+	IPAddress a = _broadcast_address;
+	if ( a == INADDR_NONE ) {
+		a = wUDP->remoteIP();
+	}
+	
+	if ( _poll_reply_pending ) {
+		if ( _poll_reply_address == a ) {
+			return;											// coalesce
+		}
+		send_poll_reply_to(wUDP, _poll_reply_address);	// unicast to other controller can't wait
+	}
+	
+	// 16 bit xorshift
+	_poll_reply_random ^= _poll_reply_random << 7;
+	_poll_reply_random ^= _poll_reply_random >> 9;
+	_poll_reply_random ^= _poll_reply_random << 8;
+	
+	_poll_reply_address = a;
+	_poll_reply_due = millis() + ( _poll_reply_random % ((uint32_t)_poll_reply_max_delay + 1) );
+	_poll_reply_pending = 1;
+}
+
+/*
+  Art-Net 4 targeted mode:  flags bit 5 set and packet includes
+  [14][15] top and [16][17] bottom of Port-Address range (hi byte first)
+*/
+uint8_t LXArtNet::pollTargetsThisNode( int packetSize ) {
+	if ( packetSize >= ARTNET_POLL_TARGETED_SIZE ) {
+		if ( _packet_buffer[12] & ARTNET_POLL_FLAG_TARGETED ) {
+			uint16_t port_address = (_net << 8) | _universe;
+			uint16_t top = (_packet_buffer[14] << 8) | _packet_buffer[15];
+			uint16_t bottom = (_packet_buffer[16] << 8) | _packet_buffer[17];
+			if (( port_address < bottom ) || ( port_address > top )) {
+				return 0;
+			}
+		}
+	}
+	return 1;
 }
 
 void LXArtNet::send_art_tod ( UDP* wUDP, uint8_t* todata, uint8_t ucount ) {
@@ -522,6 +902,17 @@ void LXArtNet::send_art_rdm ( UDP* wUDP, uint8_t* rdmdata, IPAddress toa ) {
 	wUDP->endPacket();
 }
 
+uint8_t LXArtNet::send_art_rdm_response ( UDP* wUDP, uint8_t* rdmdata ) {
+	if ( _rdm_queue != NULL ) {
+		IPAddress requester;
+		if ( _rdm_queue->matchResponse(rdmdata, &requester) ) {
+			send_art_rdm(wUDP, rdmdata, requester);
+			return 1;
+		}
+	}
+	return 0;
+}
+
 void LXArtNet::setArtTodRequestCallback(ArtNetDataRecvCallback callback) {
 	_art_tod_req_callback = callback;
 }
@@ -530,6 +921,10 @@ void LXArtNet::setArtRDMCallback(ArtNetDataRecvCallback callback) {
 	_art_rdm_callback = callback;
 }
 
+void LXArtNet::setRDMQueue(LXArtNetRDMQueue* queue) {
+	_rdm_queue = queue;
+}
+
 void LXArtNet::setArtCommandCallback(ArtNetDataRecvCallback callback) {
 	_art_cmd_callback = callback;
 }
@@ -538,6 +933,46 @@ void LXArtNet::setArtPollReplyCallback(ArtNetDataRecvCallback callback) {
 	_art_poll_reply_callback = callback;
 }
 
+void LXArtNet::getCounters ( LXDMXCounters* c ) {
+	_counters.snapshot(c);
+}
+
+void LXArtNet::resetCounters ( void ) {
+	_counters.reset();
+}
+
+uint32_t LXArtNet::dmxReceivedTime ( void ) {
+	return _dmx_received_time;
+}
+
+void LXArtNet::setLatencyMonitor ( LXDMXLatency* monitor ) {
+	_latency_monitor = monitor;
+}
+
+void LXArtNet::setDMXReceivedCallback ( LXDMXReceivedCallback callback ) {
+	_dmx_received_callback = callback;
+}
+
+void LXArtNet::setUniverseStore ( LXDMXUniverseStore* store, uint8_t index ) {
+	_universe_store = store;
+	_store_index = index;
+}
+
+uint8_t LXArtNet::counter_index ( uint16_t opcode ) {
+	switch ( opcode ) {
+		case ARTNET_ART_POLL:			return ARTNET_COUNT_POLL;
+		case ARTNET_ART_POLL_REPLY:		return ARTNET_COUNT_POLL_REPLY;
+		case ARTNET_ART_CMD:			return ARTNET_COUNT_CMD;
+		case ARTNET_ART_DMX:			return ARTNET_COUNT_DMX;
+		case ARTNET_ART_ADDRESS:		return ARTNET_COUNT_ADDRESS;
+		case ARTNET_ART_IPPROG:			return ARTNET_COUNT_IPPROG;
+		case ARTNET_ART_TOD_REQUEST:	return ARTNET_COUNT_TOD_REQUEST;
+		case ARTNET_ART_TOD_CONTROL:	return ARTNET_COUNT_TOD_CONTROL;
+		case ARTNET_ART_RDM:			return ARTNET_COUNT_RDM;
+	}
+	return ARTNET_COUNT_OTHER;
+}
+
 uint16_t LXArtNet::parse_header( void ) {
   if ( strcmp((const char*)_packet_buffer, "Art-Net") == 0 ) {
     return _packet_buffer[9] * 256 + _packet_buffer[8];  //opcode lo byte first
@@ -545,6 +980,13 @@ uint16_t LXArtNet::parse_header( void ) {
   return ARTNET_NOP;
 }
 
+uint8_t LXArtNet::other_universe( void ) {
+  if (( parse_header() == ARTNET_ART_DMX ) && ( _reply_buffer[174] == 0x80 )) {
+    return (( _packet_buffer[14] != _universe ) || ( _packet_buffer[15] != _net ));
+  }
+  return 0;
+}
+
 /*
   reads an ARTNET_ART_ADDRESS packet
   can set output universe
@@ -575,13 +1017,13 @@ uint16_t LXArtNet::parse_art_address( UDP* wUDP ) {
 		   if ( _using_htp ) {
 				if ( _dmx_sender != wUDP->remoteIP() ) {
 					_dmx_sender =   (uint32_t)0;
-					for(int k=0; k<DMX_UNIVERSE_SIZE; k++) {
+					for(int k=0; k<_htp_size; k++) {
 						_dmx_buffer_a[k] = 0;
 					}
 				}
 				if ( _dmx_sender_b != wUDP->remoteIP() ) {
 					_dmx_sender_b = (uint32_t)0;
-					for(int k=0; k<DMX_UNIVERSE_SIZE; k++) {
+					for(int k=0; k<_htp_size; k++) {
 						_dmx_buffer_b[k] = 0;
 					}
 				}
@@ -596,7 +1038,7 @@ uint16_t LXArtNet::parse_art_address( UDP* wUDP ) {
 	   		if ( _using_htp ) {
 	   			_dmx_sender = (uint32_t)0;
 	   			_dmx_sender_b = (uint32_t)0;
-				for(int j=0; j<DMX_UNIVERSE_SIZE; j++) {
+				for(int j=0; j<_htp_size; j++) {
 				   _dmx_buffer_a[j] = 0;
 				   _dmx_buffer_b[j] = 0;
 				}
@@ -641,11 +1083,16 @@ uint16_t LXArtNet::parse_art_tod_control( UDP* wUDP ) {
 	return ARTNET_NOP;
 }
 
-uint16_t LXArtNet::parse_art_rdm( UDP* wUDP ) {
-	if ( _art_rdm_callback != NULL ) {
-		if ( _packet_buffer[21] == _net ) {
-			if ( _packet_buffer[23] == _universe ) {
-				_art_rdm_callback(&_packet_buffer[24]);
+uint16_t LXArtNet::parse_art_rdm( UDP* wUDP, int packetSize ) {
+	if ( _packet_buffer[21] == _net ) {
+		if ( _packet_buffer[23] == _universe ) {
+			if ( _rdm_queue != NULL ) {		// queue request, responder is driven from loop
+				uint8_t added = _rdm_queue->addRequest(&_packet_buffer[ARTNET_RDM_OFFSET], packetSize - ARTNET_RDM_OFFSET, wUDP->remoteIP());
+				if ( added != RDM_ADD_INVALID ) {	// queued or counted as overflow
+					return ARTNET_ART_RDM;
+				}
+			} else if ( _art_rdm_callback != NULL ) {
+				_art_rdm_callback(&_packet_buffer[ARTNET_RDM_OFFSET]);
 				return ARTNET_ART_RDM;
 			}
 		}
@@ -705,11 +1152,11 @@ void  LXArtNet::initializePollReply  ( void ) {
 void  LXArtNet::setOutputFromNetworkMode  ( uint8_t can_output ) {
   if ( can_output ) {
      _reply_buffer[174] = 0x80;  // can output from network
-     _reply_buffer[182] = 0x80;  // good output 			//should be updated as needed
+     _reply_buffer[182] = 0x80;  // good output 			//updated when reply is sent
      _reply_buffer[178] = 0x08;  // input disabled
   } else {
      _reply_buffer[174] = 0x40;  // can input to network
      _reply_buffer[182] = 0x00;  // no output
-     _reply_buffer[178] = 0x80;  // data received 			//should be updated as needed
+     _reply_buffer[178] = 0x80;  // data received 			//updated when reply is sent
   }
 }
@@ -11,6 +11,7 @@
 #include <Arduino.h>
 #include <inttypes.h>
 #include "LXDMXEthernet.h"
+#include "LXArtNetRDMQueue.h"
 
 #define ARTNET_PORT 0x1936
 #define ARTNET_BUFFER_MAX 530
@@ -19,6 +20,25 @@
 #define ARTNET_TOD_PKT_SIZE	1228
 #define ARTNET_RDM_PKT_SIZE 281
 #define ARTNET_ADDRESS_OFFSET 17
+// bytes read to check the universe of an ArtDmx packet before reading its data
+#define ARTNET_HEADER_PEEK 18
+#define ARTNET_NODE_REPORT_OFFSET 108
+#define ARTNET_NODE_REPORT_SIZE 64
+#define ARTNET_DATA_TIMEOUT 3000
+#define ARTNET_POLL_TARGETED_SIZE 18
+#define ARTNET_POLL_FLAG_TARGETED 0x20
+
+// LXDMXArena bytes used by an LXArtNet constructed with an arena, for each configuration
+// (all instances also share the static ARTNET_REPLY_SIZE poll reply buffer)
+//
+//   configuration                               arena bytes
+//   packet buffer only                          ARTNET_ARENA_BYTES                 532
+//   enableHTP(arena)                            ARTNET_ARENA_BYTES_HTP            2068
+//   setSlotWindow(start, n), enableHTP(arena)   ARTNET_ARENA_BYTES_HTP_WINDOW(n)   532 + 3 x n (n rounded up to 4)
+//   enableLowMemoryHTP(n)                       ARTNET_ARENA_BYTES                 532, plus 2 x n from malloc
+#define ARTNET_ARENA_BYTES		LXDMX_ARENA_ALIGNED(ARTNET_BUFFER_MAX)
+#define ARTNET_ARENA_BYTES_HTP_WINDOW(n)	(ARTNET_ARENA_BYTES + 3 * LXDMX_ARENA_ALIGNED(n))
+#define ARTNET_ARENA_BYTES_HTP	ARTNET_ARENA_BYTES_HTP_WINDOW(DMX_UNIVERSE_SIZE)
 
 #define ARTNET_ART_POLL 		0x2000
 #define ARTNET_ART_POLL_REPLY	0x2100
@@ -32,6 +52,21 @@
 #define ARTNET_ART_RDM			0x8300
 #define ARTNET_NOP 				0x0000
 
+// index of RDM payload (sub start code) in ArtRDM packet
+#define ARTNET_RDM_OFFSET		24
+
+// LXDMXCounters type_count index for each opcode
+#define ARTNET_COUNT_OTHER			0
+#define ARTNET_COUNT_POLL			1
+#define ARTNET_COUNT_POLL_REPLY		2
+#define ARTNET_COUNT_CMD			3
+#define ARTNET_COUNT_DMX			4
+#define ARTNET_COUNT_ADDRESS		5
+#define ARTNET_COUNT_IPPROG			6
+#define ARTNET_COUNT_TOD_REQUEST	7
+#define ARTNET_COUNT_TOD_CONTROL	8
+#define ARTNET_COUNT_RDM			9
+
 typedef void (*ArtNetReceiveCallback)(void);
 typedef void (*ArtNetDataRecvCallback)(uint8_t* pdata);
 
@@ -72,6 +107,16 @@ class LXArtNet : public LXDMXEthernet {
 * @param buffer external buffer for UDP packets
 */ 
 	LXArtNet ( IPAddress address, IPAddress subnet_mask, uint8_t* buffer );
+/*!
+* @brief constructor creates instance with packet buffer taken from an arena
+* @discussion uses ARTNET_ARENA_BYTES.  If the arena is too small there is no packet buffer:
+*             dmxData() returns NULL, slot accessors read 0 and ignore writes, and no
+*             packets are read or sent.
+* @param address sent in ArtPollReply
+* @param subnet_mask used to set broadcast address
+* @param arena LXDMXArena with at least ARTNET_ARENA_BYTES remaining
+*/ 
+	LXArtNet ( IPAddress address, IPAddress subnet_mask, LXDMXArena* arena );
 	
 	
 /*!
@@ -124,6 +169,11 @@ class LXArtNet : public LXDMXEthernet {
 * @param s subnet 0-127 + flag 0x80
 */
    void    setNetAddress   ( uint8_t s );
+/*!
+* @brief net for sending and receiving
+* @return net 0-127, high 7 bits of 15 bit Port-Address
+*/
+   uint8_t net             ( void );
    
 /*!
 * @brief set local IPAddress for ArtPollReply
@@ -141,8 +191,52 @@ class LXArtNet : public LXDMXEthernet {
                          Read the data from the HTP buffer using getHTPSlot(n).
                          enableHTP() is not available on an ATmega168, ATmega328, or
                          ATmega328P due to RAM size.
+                         If the buffers cannot be allocated, HTP is not enabled.
  */
    void    enableHTP();
+/*!
+ * @brief enables HTP merge with the three buffers taken from an arena instead of malloc
+ * @param arena LXDMXArena with ARTNET_ARENA_BYTES_HTP - ARTNET_ARENA_BYTES remaining
+ *              (ARTNET_ARENA_BYTES_HTP_WINDOW(n) - ARTNET_ARENA_BYTES after setSlotWindow)
+ * @return 1 if HTP is enabled
+ */
+   uint8_t enableHTP( LXDMXArena* arena );
+/*!
+ * @brief enables HTP merge from two sources using two buffers of the given size
+ * @discussion Only the per source buffers A and B are allocated (2 x slots bytes instead
+ *             of 3 x 512) and this is available on ATmega328 class boards.  Merged data is
+ *             written back into the packet buffer, so dmxData(), universeSpan() and the
+ *             LXDMXReceivedCallback see it until the next packet is read.  getHTPSlot()
+ *             computes max(A,B) on each call and stays valid.  Slots beyond the given size are
+ *             not received.  The trade off is a compare per getHTPSlot() call and that the
+ *             changed range in the callback is always the full range.
+ *
+ *             HTP buffer RAM (computed, in addition to the 530 byte packet buffer and,
+ *             on AVR, 2 bytes of malloc overhead per buffer):
+ *
+ *               mode                                 buffers   512 slots   64 slots
+ *               enableHTP()                          3 x 512     1536        1536
+ *               setSlotWindow(s, n), enableHTP()     3 x n       1536         192
+ *               enableLowMemoryHTP(n)                2 x n       1024         128
+ *
+ *             Per received slot each mode copies to A or B and compares A with B.  Full
+ *             and windowed HTP also compare with and write the merged buffer; low memory
+ *             HTP writes the packet buffer instead.  getHTPSlot() is one read for full and
+ *             windowed HTP, two reads and a compare for low memory HTP.
+ * @param slots number of slots to merge, 1-512.  For example, 64 uses 128 bytes.
+ * @return 1 if HTP is enabled
+ */
+   uint8_t enableLowMemoryHTP( uint16_t slots );
+/*!
+ * @brief receive only slots start to start+len-1
+ * @discussion Call before enableHTP() to allocate HTP buffers of len bytes instead of 512,
+ *             for a fixture that uses part of a universe.  Combined with enableLowMemoryHTP(n)
+ *             the buffers hold the first n slots of the window.
+ * @param start first slot 1-512
+ * @param len number of slots, reduced to fit the universe
+ * @return 1 if set, 0 if HTP is already enabled or start is invalid
+ */
+   uint8_t setSlotWindow( uint16_t start, uint16_t len );
 
  /*!
  * @brief number of slots (aka addresses or channels)
@@ -175,6 +269,25 @@ class LXArtNet : public LXDMXEthernet {
  * @param value level 0 to 255
  */  
    void     setSlot      ( int slot, uint8_t value );
+ /*!
+ * @brief copy levels of consecutive slots
+ * @param start first slot 1 to 512
+ * @param count number of slots (limited to end of universe)
+ * @param dst array of at least count bytes
+ */  
+   void     getSlots     ( int start, int count, uint8_t* dst );
+ /*!
+ * @brief set levels of consecutive slots
+ * @param start first slot 1 to 512
+ * @param count number of slots (limited to end of universe)
+ * @param src array of at least count levels
+ */  
+   void     setSlots     ( int start, int count, const uint8_t* src );
+ /*!
+ * @brief view of received universe, merged if enableHTP() has been called
+ * @return LXDMXSpan with pointer to slot 1 and number of slots
+ */  
+   LXDMXSpan universeSpan ( void );
 
  /*!
  * @brief direct pointer to dmx buffer uint8_t[]
@@ -221,6 +334,9 @@ class LXArtNet : public LXDMXEthernet {
    uint8_t readDMXPacketContents ( UDP* eUDP, int packetSize );
  /*!
  * @brief process packet, reading it into _packet_buffer
+ * @discussion The header is read first.  ArtDmx for another universe is rejected
+ *             without reading its data so the current universe's data and number of
+ *             slots are unchanged.
  * @param eUDP UDP* (used for Poll Reply if applicable)
  * @return Art-Net opcode of packet
  */
@@ -261,6 +377,25 @@ class LXArtNet : public LXDMXEthernet {
  */  
    void     send_art_poll_reply ( UDP* eUDP );
    
+ /*!
+ * @brief randomize the delay of replies to ArtPoll and ArtAddress
+ * @discussion When max_ms is zero (default) replies are sent immediately when the poll is read.
+ *             Otherwise the reply is scheduled for a random time up to max_ms later
+ *             and is sent by sendPendingPollReply().  Polls that arrive while a reply
+ *             to the same address is pending are answered by that single reply.
+ * @param max_ms maximum delay in milliseconds (Art-Net recommends up to 1000)
+ */
+   void     setPollReplyDelay   ( uint16_t max_ms );
+   
+ /*!
+ * @brief sends a scheduled ArtPollReply if its time has come
+ * @discussion Called automatically by readArtNetPacket.  Call from loop if packets
+ *             are read using readDMXPacketContents/readArtNetPacketContents.
+ * @param eUDP pointer to UDP object to be used for sending UDP packet
+ * @return 1 if a reply was sent
+ */
+   uint8_t  sendPendingPollReply ( UDP* eUDP );
+   
    /*!
  * @brief send ArtTOD packet for dmx output from network
  * @discussion 
@@ -279,6 +414,15 @@ class LXArtNet : public LXDMXEthernet {
  */ 
    void send_art_rdm ( UDP* wUDP, uint8_t* rdmdata, IPAddress toa );
    
+/*!
+ * @brief send RDM response to the controller that made the matching queued request
+ * @discussion requires an LXArtNetRDMQueue set with setRDMQueue()
+ * @param wUDP		pointer to UDP object to be used for sending UDP packet
+ * @param rdmdata	pointer to rdm response to be sent (including start code)
+ * @return 1 if the response matched a request in flight and was sent
+ */ 
+   uint8_t send_art_rdm_response ( UDP* wUDP, uint8_t* rdmdata );
+   
 /*!
  * @brief function callback when ArtTODRequest is received
  * @discussion callback pointer is to integer
@@ -293,6 +437,15 @@ class LXArtNet : public LXDMXEthernet {
 	*/
    void setArtRDMCallback(ArtNetDataRecvCallback callback);
    
+   /*!
+	* @brief queue for ArtRDM requests
+	* @discussion When a queue is set, ArtRDM packets for this port are added to the queue
+	*             instead of being passed to the ArtRDM callback.  Set to NULL to use the callback.
+	*             A request dropped because the queue is full still reads as ARTNET_ART_RDM
+	*             and is counted by the queue's overflows().
+	*/
+   void setRDMQueue(LXArtNetRDMQueue* queue);
+   
    /*!
 	* @brief function callback when ArtCommand is received
 	* @discussion callback has pointer to command string
@@ -307,9 +460,57 @@ class LXArtNet : public LXDMXEthernet {
    
    /*!
 	* @brief setup poll reply buffer to indicate output/input
+	* @discussion GoodInput/GoodOutput data and merge bits and the NodeReport
+	*             are updated from received (or sent) ArtDMX each time a reply is sent.
 	*/  
    void  setOutputFromNetworkMode  ( uint8_t can_output );
    
+/*!
+ * @brief copy snapshot of traffic counters
+ * @discussion type_count is indexed by ARTNET_COUNT_xxx
+ * @param c pointer to LXDMXCounters to receive snapshot
+ */
+   void  getCounters   ( LXDMXCounters* c );
+   
+/*!
+ * @brief zero traffic counters
+ */
+   void  resetCounters ( void );
+   
+/*!
+ * @brief time the current DMX data was received
+ * @discussion pass to LXDMXLatency outputComplete() when data has reached the output
+ * @return micros() when last DMX packet was accepted
+ */
+   uint32_t dmxReceivedTime   ( void );
+   
+/*!
+ * @brief set monitor to record arrival of each accepted DMX packet
+ * @param monitor LXDMXLatency for this universe or NULL
+ */
+   void     setLatencyMonitor ( LXDMXLatency* monitor );
+   
+/*!
+ * @brief set function called when DMX data for this universe is received
+ * @discussion called after readDMXPacket/readDMXPacketContents accepts DMX
+ * @param callback LXDMXReceivedCallback or NULL
+ */
+   void     setDMXReceivedCallback ( LXDMXReceivedCallback callback );
+   
+/*!
+ * @brief copy each DMX packet accepted to a universe of a shared store
+ * @discussion merged data is copied if enableHTP() has been called
+ * @param store LXDMXUniverseStore or NULL
+ * @param index universe index in store
+ */
+   void     setUniverseStore ( LXDMXUniverseStore* store, uint8_t index );
+   
+/*!
+ * @brief the packet buffer, slot n is at index address_offset + n
+ * @discussion Not virtual, so it is inlined by LXDMXNode.  NULL if allocation failed.
+ */
+   uint8_t* packetBuffer ( void ) { return _packet_buffer; }
+   
   private:
 /*!
 * @brief buffer that holds contents of incoming or outgoing packet
@@ -321,6 +522,12 @@ class LXArtNet : public LXDMXEthernet {
   	
 /// indicates the _packet_buffer was allocated by the constructor and is private.
 	uint8_t   _owns_buffer;
+/// indicates HTP buffers were allocated with malloc and are freed by the destructor
+	uint8_t   _owns_htp_buffers;
+/// number of slots held in each HTP buffer (512 unless low memory HTP or a slot window)
+	uint16_t  _htp_size;
+/// index of the first slot in the window (slot number - 1), set by setSlotWindow
+	uint16_t  _window_first;
 
 /// array that holds contents of outgoing ArtPollReply packet
 	static uint8_t _reply_buffer[ARTNET_REPLY_SIZE];
@@ -362,6 +569,40 @@ class LXArtNet : public LXDMXEthernet {
 /// second sender of an ArtDMX packet
   	IPAddress _dmx_sender_b;
   	
+/// millis() of last accepted ArtDMX (output mode) or sent ArtDMX (input mode)
+  	unsigned long _last_dmx_time;
+/// millis() of last ArtDMX accepted from second sender
+  	unsigned long _last_dmx_time_b;
+/// number of poll replies sent, reported in NodeReport
+  	uint16_t      _poll_reply_count;
+  	
+/// maximum random delay of ArtPollReply, zero replies immediately
+  	uint16_t      _poll_reply_max_delay;
+/// a reply is scheduled to be sent by sendPendingPollReply
+  	uint8_t       _poll_reply_pending;
+/// millis() after which the scheduled reply is sent
+  	unsigned long _poll_reply_due;
+/// destination of the scheduled reply
+  	IPAddress     _poll_reply_address;
+/// pseudo random state for reply delay, seeded by local IP so nodes differ
+  	uint16_t      _poll_reply_random;
+  	
+/// packet and DMX counters
+  	LXDMXCounterSet _counters;
+/// micros() when last DMX packet was accepted
+  	uint32_t        _dmx_received_time;
+/// optional latency/inter-arrival monitor
+  	LXDMXLatency*   _latency_monitor;
+/// called when DMX is accepted
+  	LXDMXReceivedCallback _dmx_received_callback;
+/// first and last merged slot changed by current packet (HTP)
+  	uint16_t        _changed_first;
+  	uint16_t        _changed_last;
+/// optional store shared with other receivers
+  	LXDMXUniverseStore* _universe_store;
+/// universe index in _universe_store
+  	uint8_t         _store_index;
+  	
   	/*!
     * @brief Pointer to art tod request callback
    */
@@ -372,6 +613,11 @@ class LXArtNet : public LXDMXEthernet {
    */
   	ArtNetDataRecvCallback _art_rdm_callback;
   	
+  	/*!
+    * @brief Pointer to queue for ArtRDM requests (replaces _art_rdm_callback if set)
+   */
+  	LXArtNetRDMQueue* _rdm_queue;
+  	
   	/*!
     * @brief Pointer to art Command packet received callback function
    */
@@ -388,6 +634,30 @@ class LXArtNet : public LXDMXEthernet {
 */
   	uint16_t  parse_header        ( void );	
 /*!
+* @brief true if header in packet buffer is ArtDmx for a different universe
+*/
+  	uint8_t   other_universe      ( void );
+/*!
+* @brief LXDMXCounters type_count index for opcode
+*/
+  	uint8_t   counter_index       ( uint16_t opcode );
+/*!
+* @brief write slot of HTP buffer, recording changed range
+*/
+  	void      set_merged_slot     ( uint16_t di, uint8_t value );
+/*!
+* @brief first slot of the window, in HTP buffer C or the packet buffer
+*/
+  	uint8_t*  window_data         ( void );
+/*!
+* @brief number of received slots within the window
+*/
+  	uint16_t  window_slots        ( void );
+/*!
+* @brief pass received DMX to _universe_store and _dmx_received_callback
+*/
+  	void      dmx_received        ( void );
+/*!
 * @brief utility for parsing ArtAddress packets
 * @return opcode in case command changes dmx data
 */
@@ -402,7 +672,7 @@ class LXArtNet : public LXDMXEthernet {
 /*!
 * @brief utility for parsing ArtRDM packets
 */     
-   uint16_t parse_art_rdm( UDP* wUDP );
+   uint16_t parse_art_rdm( UDP* wUDP, int packetSize );
    
 /*!
 * @brief utility for parsing ArtCommand packets
@@ -412,13 +682,37 @@ class LXArtNet : public LXDMXEthernet {
 /*!
 * @brief initialize data structures
 */
-   void  initialize  ( uint8_t* b );
+   void  initialize  ( uint8_t* b, uint8_t owns );
 
 /*!
 * @brief calls art_poll_reply_callback
 */     
    uint16_t parse_art_poll_reply( UDP* wUDP );
    
+/*!
+* @brief true unless ArtPoll is targeted and our Port-Address is outside its range
+*/
+   uint8_t  pollTargetsThisNode  ( int packetSize );
+   
+/*!
+* @brief send reply now or schedule it if setPollReplyDelay is non-zero
+*/
+   void     schedule_poll_reply  ( UDP* wUDP );
+   
+/*!
+* @brief update GoodInput, GoodOutput and NodeReport before a reply is sent
+*/
+   void     update_poll_reply_status ( void );
+/*!
+* @brief write value in decimal, zero padded to digits (1-10), return end of string
+*/
+   static char* append_decimal ( char* p, uint32_t value, uint8_t digits );
+   
+/*!
+* @brief write the reply buffer to address a
+*/
+   void     send_poll_reply_to   ( UDP* wUDP, IPAddress a );
+   
 /*!
 * @brief initialize poll reply buffer
 */
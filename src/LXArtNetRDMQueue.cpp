@@ -0,0 +1,158 @@
+/* LXArtNetRDMQueue.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXArtNetRDMQueue holds ArtRDM requests until the DMX line is free
+   and routes responses back to the controller that made the request.
+
+	Art-Net(TM) Designed by and Copyright Artistic Licence Holdings Ltd.
+*/
+
+#include "LXArtNetRDMQueue.h"
+
+LXArtNetRDMQueue::LXArtNetRDMQueue ( void ) {
+	_timeout = ARTNET_RDM_QUEUE_TIMEOUT;
+	_overflows = 0;
+	clear();
+}
+
+LXArtNetRDMQueue::~LXArtNetRDMQueue ( void ) {
+}
+
+/*
+  rdmdata is the ArtRDM payload which begins with the sub start code
+  [0] sub start code  [1] message length  [2-7] destination UID
+  [8-13] source UID   [14] transaction number
+  The message length counts the start code but not the two checksum bytes
+  so the payload without the start code is mlen+1 bytes including checksum
+*/
+uint8_t LXArtNetRDMQueue::addRequest ( uint8_t* rdmdata, uint16_t length, IPAddress requester ) {
+	if (( length < 24 ) || ( rdmdata[0] != 0x01 )) {
+		return RDM_ADD_INVALID;
+	}
+	uint8_t mlen = rdmdata[1];
+	if (( mlen < 24 ) || ( length < mlen + 1 )) {	// not all of message received
+		return RDM_ADD_INVALID;
+	}
+
+	uint8_t i;
+	uint8_t k;
+	for ( i=0; i<_count; i++ ) {		// ignore retry of request already queued
+		LXArtNetRDMTransaction* t = &_queue[(_head + i) % ARTNET_RDM_QUEUE_SIZE];
+		if (( t->requester == requester ) && ( t->transaction == rdmdata[14] )) {
+			if ( memcmp(t->uid, &rdmdata[2], RDM_UID_LENGTH) == 0 ) {
+				return RDM_ADD_QUEUED;
+			}
+		}
+	}
+
+	if ( _count >= ARTNET_RDM_QUEUE_SIZE ) {
+		_overflows++;
+		return RDM_ADD_FULL;
+	}
+
+	LXArtNetRDMTransaction* t = &_queue[(_head + _count) % ARTNET_RDM_QUEUE_SIZE];
+	t->state = RDM_QUEUE_PENDING;
+	t->transaction = rdmdata[14];
+	for ( k=0; k<RDM_UID_LENGTH; k++ ) {
+		t->uid[k] = rdmdata[2+k];
+	}
+	t->requester = requester;
+	t->timestamp = millis();
+	t->packet[0] = 0xCC;						// RDM start code
+	memcpy(&t->packet[1], rdmdata, mlen+1);	// rest of message plus checksum
+	_count++;
+	return RDM_ADD_QUEUED;
+}
+
+uint8_t* LXArtNetRDMQueue::nextRequest ( void ) {
+	if ( _count == 0 ) {
+		return NULL;
+	}
+	LXArtNetRDMTransaction* t = &_queue[_head];
+	if ( t->state == RDM_QUEUE_IN_FLIGHT ) {
+		if ( ! isBroadcast(t) ) {
+			return NULL;						// still waiting for response
+		}
+		removeHead();							// no response to broadcast
+		if ( _count == 0 ) {
+			return NULL;
+		}
+		t = &_queue[_head];
+	}
+	t->state = RDM_QUEUE_IN_FLIGHT;
+	t->timestamp = millis();
+	return t->packet;
+}
+
+/*
+  rdmdata is a response including the start code
+  [0] start code  [1] sub start code  [2] message length
+  [3-8] destination UID  [9-14] source UID  [15] transaction number
+*/
+uint8_t LXArtNetRDMQueue::matchResponse ( uint8_t* rdmdata, IPAddress* requester ) {
+	if ( _count == 0 ) {
+		return 0;
+	}
+	LXArtNetRDMTransaction* t = &_queue[_head];
+	if ( t->state == RDM_QUEUE_IN_FLIGHT ) {
+		if ( t->transaction == rdmdata[15] ) {
+			if ( memcmp(t->uid, &rdmdata[9], RDM_UID_LENGTH) == 0 ) {
+				*requester = t->requester;
+				removeHead();
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+uint8_t LXArtNetRDMQueue::checkTimeouts ( void ) {
+	uint8_t removed = 0;
+	unsigned long now = millis();
+	while ( _count ) {		// requests behind one in flight are checked once it is removed
+		if ( ( now - _queue[_head].timestamp ) > _timeout ) {
+			removeHead();
+			removed++;
+		} else {
+			break;
+		}
+	}
+	return removed;
+}
+
+void LXArtNetRDMQueue::setTimeout ( uint16_t ms ) {
+	_timeout = ms;
+}
+
+uint8_t LXArtNetRDMQueue::count ( void ) {
+	return _count;
+}
+
+uint32_t LXArtNetRDMQueue::overflows ( void ) {
+	return _overflows;
+}
+
+void LXArtNetRDMQueue::clear ( void ) {
+	for ( uint8_t i=0; i<ARTNET_RDM_QUEUE_SIZE; i++ ) {
+		_queue[i].state = RDM_QUEUE_EMPTY;
+	}
+	_head = 0;
+	_count = 0;
+}
+
+void LXArtNetRDMQueue::removeHead ( void ) {
+	_queue[_head].state = RDM_QUEUE_EMPTY;
+	_head = (_head + 1) % ARTNET_RDM_QUEUE_SIZE;
+	_count--;
+}
+
+// all-call FFFF:FFFFFFFF or manufacturer broadcast mmmm:FFFFFFFF
+uint8_t LXArtNetRDMQueue::isBroadcast ( LXArtNetRDMTransaction* t ) {
+	for ( uint8_t k=2; k<RDM_UID_LENGTH; k++ ) {
+		if ( t->uid[k] != 0xFF ) {
+			return 0;
+		}
+	}
+	return 1;
+}
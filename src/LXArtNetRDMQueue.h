@@ -0,0 +1,152 @@
+/* LXArtNetRDMQueue.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+	Art-Net(TM) Designed by and Copyright Artistic Licence Holdings Ltd.
+*/
+
+#ifndef LXARTNETRDMQUEUE_H
+#define LXARTNETRDMQUEUE_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+
+// number of ArtRDM requests that can be waiting for the DMX line at one time
+#ifndef ARTNET_RDM_QUEUE_SIZE
+#define ARTNET_RDM_QUEUE_SIZE 4
+#endif
+
+// largest RDM packet, start code through checksum
+#define ARTNET_RDM_MAX_PKT 257
+// default time in milliseconds a request may wait in the queue or for its response
+#define ARTNET_RDM_QUEUE_TIMEOUT 1000
+#define RDM_UID_LENGTH 6
+
+#define RDM_QUEUE_EMPTY		0
+#define RDM_QUEUE_PENDING	1
+#define RDM_QUEUE_IN_FLIGHT	2
+
+// results of addRequest
+#define RDM_ADD_INVALID		0
+#define RDM_ADD_QUEUED		1
+#define RDM_ADD_FULL		2
+
+/*!
+* @brief an ArtRDM request waiting for, or being processed by, the RDM responder
+*/
+typedef struct {
+/// RDM_QUEUE_EMPTY, RDM_QUEUE_PENDING or RDM_QUEUE_IN_FLIGHT
+	uint8_t       state;
+/// transaction number of the request
+	uint8_t       transaction;
+/// destination UID of the request (source UID of the expected response)
+	uint8_t       uid[RDM_UID_LENGTH];
+/// address of the controller that sent the ArtRDM packet
+	IPAddress     requester;
+/// millis() when queued, replaced by millis() when sent to the responder
+	unsigned long timestamp;
+/// RDM packet including start code, ready to be sent on the DMX line
+	uint8_t       packet[ARTNET_RDM_MAX_PKT];
+} LXArtNetRDMTransaction;
+
+/*!
+@class LXArtNetRDMQueue
+@abstract
+   LXArtNetRDMQueue holds ArtRDM requests from one or more controllers
+   until the DMX line is free to send them.
+
+   RDM is half duplex so only the request at the head of the queue is ever in flight.
+   Requests are keyed by requester IP, transaction number and destination UID.
+   Responses are matched by transaction number and the responder's UID and routed
+   back to the IP address of the controller that made the request.
+
+   Attach a queue to LXArtNet with setRDMQueue().  ArtRDM packets are then queued
+   by readArtNetPacket instead of being passed to the ArtRDM callback.  The loop that
+   drives the DMX line calls nextRequest() when it is free to send, passes any response
+   to LXArtNet::send_art_rdm_response() and calls checkTimeouts() periodically.
+   Nothing blocks waiting for a response.
+*/
+class LXArtNetRDMQueue {
+
+  public:
+	LXArtNetRDMQueue ( void );
+   ~LXArtNetRDMQueue ( void );
+
+/*!
+* @brief queue an ArtRDM request
+* @discussion A request that duplicates one already in the queue (controller retry) is ignored.
+*             A request dropped because the queue is full is counted by overflows().
+* @param rdmdata RDM payload of ArtRDM packet (sub start code, no start code)
+* @param length number of bytes of rdmdata received
+* @param requester address of the controller that sent the ArtRDM packet
+* @return RDM_ADD_QUEUED if queued or already present, RDM_ADD_FULL if dropped, RDM_ADD_INVALID
+*/
+	uint8_t addRequest ( uint8_t* rdmdata, uint16_t length, IPAddress requester );
+
+/*!
+* @brief next request to send on the DMX line
+* @discussion The returned request becomes in flight until its response is matched
+*             or it times out.  Requests to a broadcast UID expect no response and are
+*             removed on the following call.
+* @return pointer to RDM packet including start code or NULL if none is ready or a request is in flight
+*/
+	uint8_t* nextRequest ( void );
+
+/*!
+* @brief match a response with the request in flight
+* @param rdmdata RDM response including start code
+* @param requester set to the address of the controller that made the request
+* @return 1 if the response matched the request in flight (which is then removed)
+*/
+	uint8_t matchResponse ( uint8_t* rdmdata, IPAddress* requester );
+
+/*!
+* @brief remove requests that have timed out, either waiting in the queue or in flight
+* @return number of requests removed
+*/
+	uint8_t checkTimeouts ( void );
+
+/*!
+* @brief set the time a request may wait to be sent or for a response
+* @param ms timeout in milliseconds
+*/
+	void setTimeout ( uint16_t ms );
+
+/*!
+* @brief number of requests in the queue including any in flight
+*/
+	uint8_t count ( void );
+
+/*!
+* @brief number of requests dropped because the queue was full
+*/
+	uint32_t overflows ( void );
+
+/*!
+* @brief discard all requests
+*/
+	void clear ( void );
+
+  private:
+/// ring of requests, head is oldest
+	LXArtNetRDMTransaction _queue[ARTNET_RDM_QUEUE_SIZE];
+/// index of oldest request
+	uint8_t  _head;
+/// number of requests in queue
+	uint8_t  _count;
+/// timeout in milliseconds
+	uint16_t _timeout;
+/// requests dropped, queue full
+	uint32_t _overflows;
+
+/*!
+* @brief remove the request at the head of the queue
+*/
+	void     removeHead ( void );
+/*!
+* @brief true if request's destination is a broadcast UID (no response expected)
+*/
+	uint8_t  isBroadcast ( LXArtNetRDMTransaction* t );
+};
+
+#endif // ifndef LXARTNETRDMQUEUE_H
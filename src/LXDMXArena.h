@@ -0,0 +1,95 @@
+/* LXDMXArena.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXARENA_H
+#define LXDMXARENA_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+// allocations are rounded up to a multiple of this so any buffer may hold 32 bit values
+#define LXDMX_ARENA_ALIGN 4
+#define LXDMX_ARENA_ALIGNED(n) ((((n) + LXDMX_ARENA_ALIGN - 1) / LXDMX_ARENA_ALIGN) * LXDMX_ARENA_ALIGN)
+
+/*!
+* @brief declare a statically allocated arena of size bytes
+* @discussion size is known at compile time so RAM use is shown by the linker
+*             example:  LXDMX_STATIC_ARENA(dmxArena, ARTNET_ARENA_BYTES_HTP);
+*/
+#define LXDMX_STATIC_ARENA(name, size) \
+	static uint8_t name##_memory[LXDMX_ARENA_ALIGNED(size)] __attribute__((aligned(LXDMX_ARENA_ALIGN))); \
+	LXDMXArena name(name##_memory, LXDMX_ARENA_ALIGNED(size))
+
+/*!
+@class LXDMXArena
+@abstract
+   LXDMXArena hands out buffers from a block of memory supplied by the caller,
+   a global array or LXDMX_STATIC_ARENA, so that no buffers are allocated with malloc.
+
+   Buffers are never freed individually.  They last as long as the memory block,
+   which suits objects created once in setup() on boards that run indefinitely
+   without fragmenting the heap.
+
+   The bytes needed for each configuration are tabled with the classes that use an arena:
+   ARTNET_ARENA_BYTES... in LXArtNet.h, SACN_ARENA_BYTES... in LXSACN.h and
+   LXDMX_STORE_ARENA_BYTES(n).  Sum these for the objects sharing an arena.
+*/
+class LXDMXArena {
+
+  public:
+/*!
+* @brief constructor with caller supplied memory
+* @param memory start of block, should be 4 byte aligned
+* @param size size of block in bytes
+*/
+	LXDMXArena ( uint8_t* memory, size_t size ) {
+		_memory = memory;
+		_size = size;
+		_used = 0;
+	}
+
+/*!
+* @brief take n bytes from the arena
+* @return pointer to buffer, NULL if not enough remains
+*/
+	uint8_t* allocate ( size_t n ) {
+		if ( n > ( _size - _used )) {		// before rounding up so n near SIZE_MAX cannot wrap
+			return NULL;
+		}
+		size_t an = LXDMX_ARENA_ALIGNED(n);
+		if ( an > ( _size - _used )) {
+			return NULL;
+		}
+		uint8_t* p = &_memory[_used];
+		_used += an;
+		return p;
+	}
+
+/*!
+* @brief bytes allocated
+*/
+	size_t   used      ( void ) { return _used; }
+/*!
+* @brief bytes available
+*/
+	size_t   remaining ( void ) { return _size - _used; }
+/*!
+* @brief total size of arena
+*/
+	size_t   size      ( void ) { return _size; }
+
+/*!
+* @brief release all buffers
+* @discussion only when no object is using a buffer from this arena
+*/
+	void     reset     ( void ) { _used = 0; }
+
+  private:
+	uint8_t*  _memory;
+	size_t    _size;
+	size_t    _used;
+};
+
+#endif // ifndef LXDMXARENA_H
@@ -0,0 +1,174 @@
+/* LXDMXCounters.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXCOUNTERS_H
+#define LXDMXCOUNTERS_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+
+// packet types counted per protocol (Art-Net opcode or sACN root vector)
+#define LXDMX_COUNTER_TYPES 10
+
+// reasons a DMX packet is rejected
+#define LXDMX_REJECT_BAD_HEADER		0
+#define LXDMX_REJECT_SHORT_PACKET	1
+#define LXDMX_REJECT_WRONG_UNIVERSE	2
+#define LXDMX_REJECT_WRONG_SENDER	3
+#define LXDMX_REJECT_REASONS		4
+
+// merge sources: first (A) and second (B) sender
+#define LXDMX_COUNTER_SOURCES 2
+
+// rate window in milliseconds
+#define LXDMX_RATE_WINDOW 1000
+
+// counters add about 80 bytes to each receiver, not enough RAM on these
+// define LXDMX_COUNTERS_ENABLED as 0 or 1 to override
+#ifndef LXDMX_COUNTERS_ENABLED
+#if defined(__AVR_ATmega168__) || defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__)
+#define LXDMX_COUNTERS_ENABLED 0
+#else
+#define LXDMX_COUNTERS_ENABLED 1
+#endif
+#endif
+
+/*!
+* @brief snapshot of receiver traffic counters
+* @discussion type_count is indexed by the protocol's counter index,
+*             see ARTNET_COUNT_xxx in LXArtNet.h and SACN_COUNT_xxx in LXSACN.h
+*/
+typedef struct {
+/// every packet read
+	uint32_t packets;
+/// packets by opcode (Art-Net) or vector (sACN)
+	uint32_t type_count[LXDMX_COUNTER_TYPES];
+/// DMX packets accepted for this universe
+	uint32_t dmx_accepted;
+/// DMX packets rejected, indexed by LXDMX_REJECT_xxx
+	uint32_t dmx_rejected[LXDMX_REJECT_REASONS];
+/// DMX packets merged with data from a second source
+	uint32_t merge_events;
+/// accepted packets per second from first and second source
+	uint16_t source_rate[LXDMX_COUNTER_SOURCES];
+} LXDMXCounters;
+
+#if LXDMX_COUNTERS_ENABLED
+
+/*!
+@class LXDMXCounterSet
+@abstract
+   LXDMXCounterSet accumulates LXDMXCounters for a receiver.
+   Each count is an increment so counters can stay on in production.
+   Per source rates are packets counted over a one second window.
+*/
+class LXDMXCounterSet {
+
+  public:
+	LXDMXCounterSet ( void ) { reset(); }
+
+/*!
+* @brief count a packet read, type is protocol counter index
+*/
+	void countPacket ( uint8_t type ) {
+		_counters.packets++;
+		if ( type < LXDMX_COUNTER_TYPES ) {
+			_counters.type_count[type]++;
+		}
+	}
+
+/*!
+* @brief count a DMX packet accepted from source 0 (A) or 1 (B)
+*/
+	void countAccepted ( uint8_t source ) {
+		_counters.dmx_accepted++;
+		unsigned long now = millis();
+		if ( (now - _window_start) >= LXDMX_RATE_WINDOW ) {
+			for ( uint8_t i=0; i<LXDMX_COUNTER_SOURCES; i++ ) {
+				_counters.source_rate[i] = _window_count[i];
+				_window_count[i] = 0;
+			}
+			_window_start = now;
+		}
+		if ( source < LXDMX_COUNTER_SOURCES ) {
+			_window_count[source]++;
+		}
+	}
+
+/*!
+* @brief count a DMX packet rejected for reason LXDMX_REJECT_xxx
+*/
+	void countRejected ( uint8_t reason ) {
+		_counters.dmx_rejected[reason]++;
+	}
+
+/*!
+* @brief count DMX merged with a second source
+*/
+	void countMerge ( void ) {
+		_counters.merge_events++;
+	}
+
+/*!
+* @brief copy current counters
+* @discussion rates are zeroed if no DMX has been accepted for two rate windows
+*/
+	void snapshot ( LXDMXCounters* c ) {
+		*c = _counters;
+		if ( (millis() - _window_start) >= 2*LXDMX_RATE_WINDOW ) {
+			for ( uint8_t i=0; i<LXDMX_COUNTER_SOURCES; i++ ) {
+				c->source_rate[i] = 0;
+			}
+		}
+	}
+
+/*!
+* @brief direct access to counters (rates not adjusted)
+*/
+	const LXDMXCounters* counters ( void ) { return &_counters; }
+
+/*!
+* @brief DMX packets accepted
+*/
+	uint32_t accepted ( void ) { return _counters.dmx_accepted; }
+
+/*!
+* @brief zero all counters
+*/
+	void reset ( void ) {
+		memset(&_counters, 0, sizeof(LXDMXCounters));
+		memset(_window_count, 0, sizeof(_window_count));
+		_window_start = millis();
+	}
+
+  private:
+	LXDMXCounters _counters;
+/// packets from each source in current rate window
+	uint16_t      _window_count[LXDMX_COUNTER_SOURCES];
+/// millis() at start of rate window
+	unsigned long _window_start;
+};
+
+#else	// counters disabled, same interface with nothing counted
+
+class LXDMXCounterSet {
+
+  public:
+	void countPacket   ( uint8_t ) {}
+	void countAccepted ( uint8_t ) {}
+	void countRejected ( uint8_t ) {}
+	void countMerge    ( void ) {}
+	void snapshot      ( LXDMXCounters* c ) { memset(c, 0, sizeof(LXDMXCounters)); }
+	const LXDMXCounters* counters ( void ) {
+		static const LXDMXCounters zero = {};
+		return &zero;
+	}
+	uint32_t accepted  ( void ) { return 0; }
+	void reset         ( void ) {}
+};
+
+#endif // LXDMX_COUNTERS_ENABLED
+
+#endif // ifndef LXDMXCOUNTERS_H
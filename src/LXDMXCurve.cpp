@@ -0,0 +1,244 @@
+/* LXDMXCurve.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXCurve.h"
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#endif
+
+// 65535 x (level/255)^2.2
+static const uint16_t CURVE_GAMMA_22[256] PROGMEM = {
+	    0,     0,     2,     4,     7,    11,    17,    24,
+	   32,    42,    53,    65,    79,    94,   111,   129,
+	  148,   169,   192,   216,   242,   270,   299,   330,
+	  362,   396,   432,   469,   508,   549,   591,   635,
+	  681,   729,   779,   830,   883,   938,   995,  1053,
+	 1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+	 1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+	 2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+	 3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+	 4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+	 5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+	 6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+	 7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+	 9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+	10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+	12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+	14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+	16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+	18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+	20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+	23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+	26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+	28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+	31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+	35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+	38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+	41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+	45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+	49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+	53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+	57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+	61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535
+};
+
+// 65535 x (level/255)^2.8
+static const uint16_t CURVE_GAMMA_28[256] PROGMEM = {
+	    0,     0,     0,     0,     1,     1,     2,     3,
+	    4,     6,     8,    10,    13,    16,    19,    24,
+	   28,    33,    39,    46,    53,    60,    69,    78,
+	   88,    98,   110,   122,   135,   149,   164,   179,
+	  196,   214,   232,   252,   273,   295,   317,   341,
+	  366,   393,   420,   449,   478,   510,   542,   575,
+	  610,   647,   684,   723,   764,   806,   849,   894,
+	  940,   988,  1037,  1088,  1140,  1194,  1250,  1307,
+	 1366,  1427,  1489,  1553,  1619,  1686,  1756,  1827,
+	 1900,  1975,  2051,  2130,  2210,  2293,  2377,  2463,
+	 2552,  2642,  2734,  2829,  2925,  3024,  3124,  3227,
+	 3332,  3439,  3548,  3660,  3774,  3890,  4008,  4128,
+	 4251,  4376,  4504,  4634,  4766,  4901,  5038,  5177,
+	 5319,  5464,  5611,  5760,  5912,  6067,  6224,  6384,
+	 6546,  6711,  6879,  7049,  7222,  7397,  7576,  7757,
+	 7941,  8128,  8317,  8509,  8704,  8902,  9103,  9307,
+	 9514,  9723,  9936, 10151, 10370, 10591, 10816, 11043,
+	11274, 11507, 11744, 11984, 12227, 12473, 12722, 12975,
+	13230, 13489, 13751, 14017, 14285, 14557, 14833, 15111,
+	15393, 15678, 15967, 16259, 16554, 16853, 17155, 17461,
+	17770, 18083, 18399, 18719, 19042, 19369, 19700, 20034,
+	20372, 20713, 21058, 21407, 21759, 22115, 22475, 22838,
+	23206, 23577, 23952, 24330, 24713, 25099, 25489, 25884,
+	26282, 26683, 27089, 27499, 27913, 28330, 28752, 29178,
+	29608, 30041, 30479, 30921, 31367, 31818, 32272, 32730,
+	33193, 33660, 34131, 34606, 35085, 35569, 36057, 36549,
+	37046, 37547, 38052, 38561, 39075, 39593, 40116, 40643,
+	41175, 41711, 42251, 42796, 43346, 43899, 44458, 45021,
+	45588, 46161, 46737, 47319, 47905, 48495, 49091, 49691,
+	50295, 50905, 51519, 52138, 52761, 53390, 54023, 54661,
+	55303, 55951, 56604, 57261, 57923, 58590, 59262, 59939,
+	60621, 61308, 62000, 62697, 63399, 64106, 64818, 65535
+};
+
+// 65535 x (level/255)^2
+static const uint16_t CURVE_SQUARE[256] PROGMEM = {
+	    0,     1,     4,     9,    16,    25,    36,    49,
+	   65,    82,   101,   122,   145,   170,   198,   227,
+	  258,   291,   327,   364,   403,   444,   488,   533,
+	  581,   630,   681,   735,   790,   848,   907,   969,
+	 1032,  1098,  1165,  1235,  1306,  1380,  1455,  1533,
+	 1613,  1694,  1778,  1864,  1951,  2041,  2133,  2226,
+	 2322,  2420,  2520,  2621,  2725,  2831,  2939,  3049,
+	 3161,  3274,  3390,  3508,  3628,  3750,  3874,  4000,
+	 4128,  4258,  4390,  4524,  4660,  4798,  4938,  5081,
+	 5225,  5371,  5519,  5669,  5821,  5976,  6132,  6290,
+	 6450,  6612,  6777,  6943,  7111,  7282,  7454,  7628,
+	 7805,  7983,  8164,  8346,  8530,  8717,  8905,  9096,
+	 9288,  9483,  9679,  9878, 10078, 10281, 10486, 10692,
+	10901, 11111, 11324, 11539, 11755, 11974, 12195, 12418,
+	12642, 12869, 13098, 13329, 13562, 13796, 14033, 14272,
+	14513, 14756, 15001, 15248, 15497, 15748, 16001, 16256,
+	16513, 16772, 17033, 17296, 17561, 17828, 18097, 18368,
+	18641, 18916, 19193, 19473, 19754, 20037, 20322, 20609,
+	20899, 21190, 21483, 21778, 22076, 22375, 22676, 22980,
+	23285, 23593, 23902, 24213, 24527, 24842, 25160, 25479,
+	25801, 26124, 26450, 26777, 27107, 27439, 27772, 28108,
+	28445, 28785, 29127, 29470, 29816, 30164, 30513, 30865,
+	31219, 31575, 31933, 32292, 32654, 33018, 33384, 33752,
+	34122, 34493, 34867, 35243, 35621, 36001, 36383, 36767,
+	37153, 37541, 37931, 38323, 38717, 39113, 39511, 39912,
+	40314, 40718, 41124, 41532, 41942, 42355, 42769, 43185,
+	43603, 44024, 44446, 44870, 45297, 45725, 46155, 46588,
+	47022, 47458, 47897, 48337, 48780, 49224, 49671, 50119,
+	50570, 51022, 51477, 51933, 52392, 52852, 53315, 53780,
+	54246, 54715, 55185, 55658, 56133, 56610, 57088, 57569,
+	58052, 58537, 59023, 59512, 60003, 60496, 60991, 61488,
+	61986, 62487, 62990, 63495, 64002, 64511, 65022, 65535
+};
+
+// 65535 x (3x^2 - 2x^3), x = level/255
+static const uint16_t CURVE_S[256] PROGMEM = {
+	    0,     3,    12,    27,    48,    75,   107,   145,
+	  189,   239,   294,   355,   422,   494,   571,   654,
+	  742,   835,   934,  1037,  1146,  1260,  1379,  1503,
+	 1632,  1766,  1905,  2049,  2197,  2350,  2508,  2670,
+	 2837,  3009,  3185,  3365,  3550,  3739,  3932,  4130,
+	 4332,  4538,  4748,  4962,  5180,  5402,  5628,  5858,
+	 6092,  6330,  6571,  6816,  7064,  7316,  7572,  7831,
+	 8094,  8360,  8629,  8901,  9177,  9456,  9739, 10024,
+	10312, 10604, 10898, 11195, 11495, 11798, 12104, 12412,
+	12724, 13037, 13354, 13673, 13994, 14318, 14644, 14973,
+	15303, 15637, 15972, 16309, 16649, 16991, 17334, 17680,
+	18027, 18377, 18728, 19081, 19436, 19792, 20150, 20510,
+	20871, 21234, 21598, 21964, 22331, 22699, 23068, 23439,
+	23811, 24184, 24558, 24933, 25309, 25686, 26064, 26442,
+	26822, 27202, 27583, 27964, 28346, 28729, 29112, 29496,
+	29880, 30264, 30649, 31033, 31419, 31804, 32189, 32575,
+	32960, 33346, 33731, 34116, 34502, 34886, 35271, 35655,
+	36039, 36423, 36806, 37189, 37571, 37952, 38333, 38713,
+	39093, 39471, 39849, 40226, 40602, 40977, 41351, 41724,
+	42096, 42467, 42836, 43204, 43571, 43937, 44301, 44664,
+	45025, 45385, 45743, 46099, 46454, 46807, 47158, 47508,
+	47855, 48201, 48544, 48886, 49226, 49563, 49898, 50232,
+	50562, 50891, 51217, 51541, 51862, 52181, 52498, 52811,
+	53123, 53431, 53737, 54040, 54340, 54637, 54931, 55223,
+	55511, 55796, 56079, 56358, 56634, 56906, 57175, 57441,
+	57704, 57963, 58219, 58471, 58719, 58964, 59205, 59443,
+	59677, 59907, 60133, 60355, 60573, 60787, 60997, 61203,
+	61405, 61603, 61796, 61985, 62170, 62350, 62526, 62698,
+	62865, 63027, 63185, 63338, 63486, 63630, 63769, 63903,
+	64032, 64156, 64275, 64389, 64498, 64601, 64700, 64793,
+	64881, 64964, 65041, 65113, 65180, 65241, 65296, 65346,
+	65390, 65428, 65460, 65487, 65508, 65523, 65532, 65535
+};
+
+LXDMXCurve::LXDMXCurve ( uint8_t curve ) {
+	_user = NULL;
+	setCurve(curve);
+}
+
+LXDMXCurve::~LXDMXCurve ( void ) {
+}
+
+void LXDMXCurve::setCurve ( uint8_t curve ) {
+	_curve = curve;
+	switch ( curve ) {
+		case LXDMX_CURVE_GAMMA_22:	_table = CURVE_GAMMA_22;	break;
+		case LXDMX_CURVE_GAMMA_28:	_table = CURVE_GAMMA_28;	break;
+		case LXDMX_CURVE_SQUARE:	_table = CURVE_SQUARE;		break;
+		case LXDMX_CURVE_S:			_table = CURVE_S;			break;
+		case LXDMX_CURVE_USER:		_table = NULL;				break;
+		default:
+			_curve = LXDMX_CURVE_LINEAR;
+			_table = NULL;
+			break;
+	}
+	if (( _curve == LXDMX_CURVE_USER ) && ( _user == NULL )) {
+		_curve = LXDMX_CURVE_LINEAR;
+	}
+}
+
+uint8_t LXDMXCurve::curve ( void ) {
+	return _curve;
+}
+
+void LXDMXCurve::setUserTable ( const uint16_t* table ) {
+	_user = table;
+	setCurve(LXDMX_CURVE_USER);
+}
+
+uint16_t LXDMXCurve::value16 ( uint8_t level ) {
+	if ( _curve == LXDMX_CURVE_USER ) {
+		return _user[level];
+	}
+	if ( _table != NULL ) {
+		return pgm_read_word(&_table[level]);
+	}
+	return level * 257;				// linear, 255 -> 65535
+}
+
+uint8_t LXDMXCurve::value8 ( uint8_t level ) {
+	return value16(level) >> 8;
+}
+
+void LXDMXCurve::apply8 ( const uint8_t* src, uint8_t* dst, uint16_t count ) {
+	uint16_t i;
+	if ( _curve == LXDMX_CURVE_USER ) {
+		for (i=0; i<count; i++) {
+			dst[i] = _user[src[i]] >> 8;
+		}
+	} else if ( _table != NULL ) {
+		const uint16_t* t = _table;
+		for (i=0; i<count; i++) {
+			dst[i] = pgm_read_word(&t[src[i]]) >> 8;
+		}
+	} else if ( dst != src ) {
+		memcpy(dst, src, count);
+	}
+}
+
+void LXDMXCurve::apply16 ( const uint8_t* src, uint16_t* dst, uint16_t count ) {
+	uint16_t i;
+	if ( _curve == LXDMX_CURVE_USER ) {
+		for (i=0; i<count; i++) {
+			dst[i] = _user[src[i]];
+		}
+	} else if ( _table != NULL ) {
+		const uint16_t* t = _table;
+		for (i=0; i<count; i++) {
+			dst[i] = pgm_read_word(&t[src[i]]);
+		}
+	} else {
+		for (i=0; i<count; i++) {
+			dst[i] = src[i] * 257;
+		}
+	}
+}
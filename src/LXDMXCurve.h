@@ -0,0 +1,85 @@
+/* LXDMXCurve.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXCURVE_H
+#define LXDMXCURVE_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+
+#define LXDMX_CURVE_LINEAR		0
+#define LXDMX_CURVE_GAMMA_22	1
+#define LXDMX_CURVE_GAMMA_28	2
+#define LXDMX_CURVE_SQUARE		3
+#define LXDMX_CURVE_S			4
+#define LXDMX_CURVE_USER		5
+
+/*!
+@class LXDMXCurve
+@abstract
+   LXDMXCurve maps 8 bit DMX levels to 8 or 16 bit output levels through a
+   256 entry table.
+
+   The built in curves (gamma 2.2 and 2.8, square law and S curve) are constant
+   tables of 16 bit values stored in flash (PROGMEM) so they use no RAM.  A user
+   table of 256 16 bit values may be supplied instead.
+
+   apply8() and apply16() convert a block of slots in one pass, a single
+   table read per channel.  The 16 bit output gives drivers with 12 to 16 bit PWM
+   smooth dimming at low levels where 8 bit gamma correction has visible steps.
+
+   LXDMXCurve curve(LXDMX_CURVE_GAMMA_22);
+   curve.apply8(span.slots, pixels, span.count);
+*/
+class LXDMXCurve {
+
+  public:
+/*!
+* @brief constructor
+* @param curve LXDMX_CURVE_LINEAR, LXDMX_CURVE_GAMMA_22, LXDMX_CURVE_GAMMA_28, LXDMX_CURVE_SQUARE or LXDMX_CURVE_S
+*/
+	LXDMXCurve ( uint8_t curve );
+   ~LXDMXCurve ( void );
+
+/*!
+* @brief select a built in curve
+*/
+	void     setCurve     ( uint8_t curve );
+	uint8_t  curve        ( void );
+
+/*!
+* @brief use a table in RAM, selects LXDMX_CURVE_USER
+* @param table 256 output levels 0-65535, must remain valid while in use
+*/
+	void     setUserTable ( const uint16_t* table );
+
+/*!
+* @brief 16 bit output (0-65535) for level
+*/
+	uint16_t value16      ( uint8_t level );
+/*!
+* @brief 8 bit output (0-255) for level
+*/
+	uint8_t  value8       ( uint8_t level );
+
+/*!
+* @brief convert count levels to 8 bit output
+* @discussion src and dst may be the same buffer to convert in place
+*/
+	void     apply8       ( const uint8_t* src, uint8_t* dst, uint16_t count );
+/*!
+* @brief convert count levels to 16 bit output
+*/
+	void     apply16      ( const uint8_t* src, uint16_t* dst, uint16_t count );
+
+  private:
+	uint8_t         _curve;
+/// built in table in flash, NULL for linear
+	const uint16_t* _table;
+/// user table in RAM
+	const uint16_t* _user;
+};
+
+#endif // ifndef LXDMXCURVE_H
@@ -0,0 +1,209 @@
+/* LXDMXDispatcher.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXDispatcher.h"
+
+static const uint8_t ARTNET_ID[] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+static const uint8_t ACN_ID[] = { 0x00, 0x10, 0x00, 0x00, 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0x00, 0x00, 0x00 };
+
+LXDMXDispatcher::LXDMXDispatcher ( uint8_t* buffer, uint16_t size ) {
+	_buffer = buffer;
+	_buffer_size = size;
+	clear();
+}
+
+LXDMXDispatcher::~LXDMXDispatcher ( void ) {
+}
+
+uint8_t LXDMXDispatcher::addReceiver ( LXArtNet* receiver ) {
+	if ( _count >= LXDMX_DISPATCH_MAX_RECEIVERS ) {
+		return 0;
+	}
+	_receivers[_count] = receiver;
+	_protocols[_count] = LXDMX_PROTOCOL_ARTNET;
+	if ( ! insert(_count) ) {
+		return 0;
+	}
+	if ( _primary_artnet == NULL ) {
+		_primary_artnet = receiver;
+	}
+	_count++;
+	return 1;
+}
+
+uint8_t LXDMXDispatcher::addReceiver ( LXSACN* receiver ) {
+	if ( _count >= LXDMX_DISPATCH_MAX_RECEIVERS ) {
+		return 0;
+	}
+	_receivers[_count] = receiver;
+	_protocols[_count] = LXDMX_PROTOCOL_SACN;
+	if ( ! insert(_count) ) {
+		return 0;
+	}
+	_count++;
+	return 1;
+}
+
+void LXDMXDispatcher::clear ( void ) {
+	_count = 0;
+	_primary_artnet = NULL;
+	memset(_table, 0, sizeof(_table));
+}
+
+void LXDMXDispatcher::rebuild ( void ) {
+	memset(_table, 0, sizeof(_table));
+	for (uint8_t i=0; i<_count; i++) {
+		insert(i);			// if two receivers now share a universe, the first keeps it
+	}
+}
+
+LXDMXEthernet* LXDMXDispatcher::receiverFor ( uint8_t protocol, uint16_t universe ) {
+	uint8_t h = hash(protocol, universe);
+	for (uint8_t n=0; n<LXDMX_DISPATCH_TABLE_SIZE; n++) {
+		if ( _table[h] == 0 ) {
+			return NULL;
+		}
+		if (( _keys[h] == universe ) && ( _key_protocols[h] == protocol )) {
+			return _receivers[_table[h]-1];
+		}
+		h = ( h + 1 ) & ( LXDMX_DISPATCH_TABLE_SIZE - 1 );
+	}
+	return NULL;
+}
+
+uint8_t LXDMXDispatcher::readPacket ( UDP* eUDP ) {
+	if ( _primary_artnet != NULL ) {
+		_primary_artnet->sendPendingPollReply(eUDP);
+	}
+	int packetSize = eUDP->parsePacket();
+	if ( packetSize > 0 ) {
+		packetSize = eUDP->read(_buffer, _buffer_size);
+		return dispatch(eUDP, packetSize);
+	}
+	return RESULT_NONE;
+}
+
+uint8_t LXDMXDispatcher::dispatchPackets ( UDP* eUDP ) {
+	uint8_t packets = 0;
+	if ( _primary_artnet != NULL ) {
+		_primary_artnet->sendPendingPollReply(eUDP);
+	}
+	while ( packets < LXDMX_DISPATCH_MAX_PACKETS ) {
+		int packetSize = eUDP->parsePacket();
+		if ( packetSize <= 0 ) {
+			break;
+		}
+		packetSize = eUDP->read(_buffer, _buffer_size);
+		dispatch(eUDP, packetSize);
+		packets++;
+	}
+	return packets;
+}
+
+uint8_t LXDMXDispatcher::dispatch ( UDP* eUDP, int packetSize ) {
+	uint16_t universe;
+	uint8_t protocol = classify(packetSize, &universe);
+	if ( protocol == LXDMX_PROTOCOL_NONE ) {
+		return RESULT_NONE;
+	}
+
+	if ( universe == 0xffff ) {
+		if ( protocol == LXDMX_PROTOCOL_ARTNET ) {
+			return dispatchArtNet(eUDP, packetSize);
+		}
+		return RESULT_NONE;
+	}
+
+	LXDMXEthernet* receiver = receiverFor(protocol, universe);
+	if ( receiver != NULL ) {
+		return receiver->readDMXPacketContents(eUDP, packetSize);
+	}
+	return RESULT_NONE;
+}
+
+uint8_t LXDMXDispatcher::dispatchArtNet ( UDP* eUDP, int packetSize ) {
+	uint16_t opcode = ( _buffer[9] << 8 ) | _buffer[8];
+	if ( opcode == ARTNET_ART_POLL ) {		// one node, one reply
+		if ( _primary_artnet != NULL ) {
+			return _primary_artnet->readDMXPacketContents(eUDP, packetSize);
+		}
+		return RESULT_NONE;
+	}
+
+	uint16_t handled = ARTNET_NOP;
+	for (uint8_t i=0; i<_count; i++) {		// first receiver that handles it
+		if ( _protocols[i] == LXDMX_PROTOCOL_ARTNET ) {
+			handled = ((LXArtNet*)_receivers[i])->readArtNetPacketContents(eUDP, packetSize);
+			if ( handled != ARTNET_NOP ) {
+				break;
+			}
+		}
+	}
+	if ( opcode == ARTNET_ART_ADDRESS ) {
+		rebuild();	// receiver may have a new Port-Address
+	}
+	if ( handled == ARTNET_ART_DMX ) {		// ArtAddress changed the receiver's output
+		return RESULT_DMX_RECEIVED;
+	}
+	if ( handled != ARTNET_NOP ) {
+		return RESULT_PACKET_COMPLETE;
+	}
+	return RESULT_NONE;
+}
+
+uint8_t LXDMXDispatcher::classify ( uint16_t size, uint16_t* universe ) {
+	*universe = 0xffff;
+	if (( size >= 12 ) &&		// header and opcode
+	     ( memcmp(_buffer, ARTNET_ID, sizeof(ARTNET_ID)) == 0 )) {
+		uint16_t opcode = ( _buffer[9] << 8 ) | _buffer[8];
+		if (( opcode == ARTNET_ART_DMX ) && ( size >= ARTNET_ADDRESS_OFFSET + 1 )) {
+			*universe = (( _buffer[15] & 0x7f ) << 8 ) | _buffer[14];
+		} else if ((( opcode == ARTNET_ART_RDM ) || ( opcode == ARTNET_ART_TOD_CONTROL )) && ( size >= 24 )) {
+			*universe = (( _buffer[21] & 0x7f ) << 8 ) | _buffer[23];	// net, address
+		} else if (( opcode == ARTNET_ART_TOD_REQUEST ) && ( size >= 25 )) {
+			*universe = (( _buffer[21] & 0x7f ) << 8 ) | _buffer[24];	// net, first address
+		}
+		return LXDMX_PROTOCOL_ARTNET;
+	}
+	if (( size > SACN_ADDRESS_OFFSET ) && ( memcmp(_buffer, ACN_ID, sizeof(ACN_ID)) == 0 )) {
+		if (( _buffer[21] == 0x04 ) && ( _buffer[43] == 0x02 )) {	// root vector data, framing vector DMP
+			*universe = ( _buffer[113] << 8 ) | _buffer[114];
+		}
+		return LXDMX_PROTOCOL_SACN;
+	}
+	return LXDMX_PROTOCOL_NONE;
+}
+
+uint16_t LXDMXDispatcher::universeOf ( uint8_t index ) {
+	if ( _protocols[index] == LXDMX_PROTOCOL_ARTNET ) {
+		LXArtNet* a = (LXArtNet*) _receivers[index];
+		return ( a->net() << 8 ) | a->universe();
+	}
+	return _receivers[index]->universe();
+}
+
+uint8_t LXDMXDispatcher::insert ( uint8_t index ) {
+	uint8_t protocol = _protocols[index];
+	uint16_t universe = universeOf(index);
+	uint8_t h = hash(protocol, universe);
+	for (uint8_t n=0; n<LXDMX_DISPATCH_TABLE_SIZE; n++) {
+		if ( _table[h] == 0 ) {
+			_table[h] = index + 1;
+			_keys[h] = universe;
+			_key_protocols[h] = protocol;
+			return 1;
+		}
+		if (( _keys[h] == universe ) && ( _key_protocols[h] == protocol )) {
+			return 0;
+		}
+		h = ( h + 1 ) & ( LXDMX_DISPATCH_TABLE_SIZE - 1 );
+	}
+	return 0;
+}
+
+uint8_t LXDMXDispatcher::hash ( uint8_t protocol, uint16_t universe ) {
+	// consecutive universes of one protocol fall in consecutive even/odd positions
+	return (( universe << 1 ) ^ protocol ) & ( LXDMX_DISPATCH_TABLE_SIZE - 1 );
+}
@@ -0,0 +1,149 @@
+/* LXDMXDispatcher.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXDISPATCHER_H
+#define LXDMXDISPATCHER_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include <Udp.h>
+#include "LXDMXEthernet.h"
+#include "LXArtNet.h"
+#include "LXSACN.h"
+
+// maximum number of receivers
+#define LXDMX_DISPATCH_MAX_RECEIVERS 8
+// hash table entries, power of two and at least twice LXDMX_DISPATCH_MAX_RECEIVERS
+#define LXDMX_DISPATCH_TABLE_SIZE 16
+// maximum packets read by one call to dispatchPackets
+#define LXDMX_DISPATCH_MAX_PACKETS 8
+
+#define LXDMX_PROTOCOL_NONE		0
+#define LXDMX_PROTOCOL_ARTNET	1
+#define LXDMX_PROTOCOL_SACN		2
+
+/*!
+@class LXDMXDispatcher
+@abstract
+   LXDMXDispatcher reads packets into a buffer shared by several LXArtNet and LXSACN
+   receivers and passes each packet only to the receiver for its universe.
+
+   Each datagram is classified once: Art-Net by its "Art-Net" header and opcode,
+   sACN by the ACN root layer preamble and packet identifier.  The universe is read
+   from the packet and looked up in a hash table, so the cost per packet does not
+   grow with the number of receivers.  The payload is not copied; the receivers must be
+   constructed with the same buffer passed to the dispatcher.
+
+   ArtRDM, ArtTodRequest and ArtTodControl are routed by their net and address the
+   same way as ArtDMX.  ArtPoll goes to the first LXArtNet receiver added, which
+   replies for the node.  Other Art-Net packets (ArtAddress, ArtCmd...) are offered to
+   each LXArtNet receiver in the order added until one handles them.  sACN packets that
+   are not for a receiver's universe are ignored.
+
+   If a receiver's universe is changed after it is added, call rebuild().
+   This is done automatically when an ArtAddress packet is received.
+*/
+class LXDMXDispatcher {
+
+  public:
+/*!
+* @brief constructor with buffer shared by receivers
+* @param buffer packet buffer, at least SACN_BUFFER_MAX if sACN receivers are used
+* @param size size of buffer
+*/
+	LXDMXDispatcher ( uint8_t* buffer, uint16_t size );
+   ~LXDMXDispatcher ( void );
+
+/*!
+* @brief add Art-Net receiver, key is its current net/subnet/universe
+* @return 1 if added, 0 if full or universe is already taken
+*/
+	uint8_t addReceiver ( LXArtNet* receiver );
+/*!
+* @brief add sACN receiver, key is its current universe
+* @return 1 if added, 0 if full or universe is already taken
+*/
+	uint8_t addReceiver ( LXSACN* receiver );
+
+/*!
+* @brief remove all receivers
+*/
+	void    clear       ( void );
+
+/*!
+* @brief rebuild lookup table from receivers' current universes
+*/
+	void    rebuild     ( void );
+
+/*!
+* @brief receiver for universe
+* @param protocol LXDMX_PROTOCOL_ARTNET or LXDMX_PROTOCOL_SACN
+* @param universe Art-Net 15 bit Port-Address or sACN universe
+* @return receiver or NULL
+*/
+	LXDMXEthernet* receiverFor ( uint8_t protocol, uint16_t universe );
+
+/*!
+* @brief read a packet and pass it to its receiver
+* @return result of receiver's readDMXPacketContents, RESULT_NONE if no receiver
+*/
+	uint8_t readPacket      ( UDP* eUDP );
+
+/*!
+* @brief read waiting packets, up to LXDMX_DISPATCH_MAX_PACKETS
+* @discussion use with LXDMXReceivedCallback on each receiver.  This is the way to
+*             service several receivers sharing one UDP object; it also sends any
+*             ArtPollReply the primary LXArtNet receiver has pending.
+* @return number of packets read
+*/
+	uint8_t dispatchPackets ( UDP* eUDP );
+
+/*!
+* @brief identify protocol of packet in buffer and read its universe
+* @param universe set to Port-Address or sACN universe for DMX, RDM and TOD packets
+* @return LXDMX_PROTOCOL_xxx, with universe set to 0xffff if packet has no universe
+*/
+	uint8_t classify        ( uint16_t size, uint16_t* universe );
+
+  private:
+/// packet buffer shared with receivers
+	uint8_t*       _buffer;
+	uint16_t       _buffer_size;
+/// receivers in order added
+	LXDMXEthernet* _receivers[LXDMX_DISPATCH_MAX_RECEIVERS];
+	uint8_t        _protocols[LXDMX_DISPATCH_MAX_RECEIVERS];
+	uint8_t        _count;
+/// first LXArtNet added, replies to ArtPoll
+	LXArtNet*      _primary_artnet;
+/// open addressed table of receiver index+1, zero is empty
+	uint8_t        _table[LXDMX_DISPATCH_TABLE_SIZE];
+/// key of each table entry
+	uint16_t       _keys[LXDMX_DISPATCH_TABLE_SIZE];
+	uint8_t        _key_protocols[LXDMX_DISPATCH_TABLE_SIZE];
+
+/*!
+* @brief pass packet in buffer to its receiver
+*/
+	uint8_t  dispatch    ( UDP* eUDP, int packetSize );
+/*!
+* @brief pass Art-Net packet with no universe to the receiver(s) that handle it
+*/
+	uint8_t  dispatchArtNet ( UDP* eUDP, int packetSize );
+/*!
+* @brief current universe of receiver at index
+*/
+	uint16_t universeOf  ( uint8_t index );
+/*!
+* @brief add receiver at index to table
+* @return 0 if universe is already in table
+*/
+	uint8_t  insert      ( uint8_t index );
+/*!
+* @brief table position for key
+*/
+	uint8_t  hash        ( uint8_t protocol, uint16_t universe );
+};
+
+#endif // ifndef LXDMXDISPATCHER_H
@@ -0,0 +1,55 @@
+/* LXDMXDither.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXDither.h"
+#include <stdlib.h>
+#include <string.h>
+
+LXDMXDither::LXDMXDither ( uint16_t channels ) {
+	_error = (uint8_t*) malloc(channels);
+	_owns_error = 1;
+	if ( _error != NULL ) {
+		_channels = channels;
+	} else {
+		_channels = 0;
+	}
+	reset();
+}
+
+LXDMXDither::LXDMXDither ( uint16_t channels, LXDMXArena* arena ) {
+	_error = arena->allocate(channels);
+	_owns_error = 0;
+	if ( _error != NULL ) {
+		_channels = channels;
+	} else {
+		_channels = 0;
+	}
+	reset();
+}
+
+LXDMXDither::~LXDMXDither ( void ) {
+	if ( _owns_error && ( _error != NULL )) {
+		free(_error);
+	}
+}
+
+uint16_t LXDMXDither::channels ( void ) {
+	return _channels;
+}
+
+void LXDMXDither::process ( const uint16_t* src, uint8_t* dst, uint16_t count ) {
+	if ( count > _channels ) {
+		count = _channels;
+	}
+	for (uint16_t i=0; i<count; i++) {
+		dst[i] = channel(i, src[i]);
+	}
+}
+
+void LXDMXDither::reset ( void ) {
+	if ( _error != NULL ) {
+		memset(_error, 0, _channels);
+	}
+}
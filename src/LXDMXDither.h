@@ -0,0 +1,81 @@
+/* LXDMXDither.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXDITHER_H
+#define LXDMXDITHER_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include "LXDMXArena.h"
+
+// LXDMXArena bytes used by an LXDMXDither of n channels
+#define LXDMX_DITHER_ARENA_BYTES(n) LXDMX_ARENA_ALIGNED(n)
+
+/*!
+@class LXDMXDither
+@abstract
+   LXDMXDither outputs 16 bit levels (from LXDMXFineChannels or LXDMXCurve apply16)
+   on 8 bit outputs by temporal dithering.
+
+   Each output frame the low byte of the level is added to the channel's
+   accumulator.  When it overflows the output is one step higher for that frame.
+   Averaged over 256 frames the output is the 16 bit level, so at a 1kHz PWM update
+   rate fades at low level are smooth rather than stepped.
+
+   The state is one byte per channel.  Call process() once per output update,
+   which should be much faster than the DMX refresh rate.
+*/
+class LXDMXDither {
+
+  public:
+/*!
+* @brief constructor allocates state for channels
+*/
+	LXDMXDither ( uint16_t channels );
+/*!
+* @brief constructor takes state for channels from an arena
+* @param arena LXDMXArena with LXDMX_DITHER_ARENA_BYTES(channels) remaining
+*/
+	LXDMXDither ( uint16_t channels, LXDMXArena* arena );
+   ~LXDMXDither ( void );
+
+/*!
+* @brief number of channels, zero if allocation failed
+*/
+	uint16_t channels ( void );
+
+/*!
+* @brief dither one channel
+* @param channel 0 to channels()-1
+* @param level 16 bit level
+* @return 8 bit output for this frame
+*/
+	uint8_t  channel  ( uint16_t channel, uint16_t level ) {
+		uint16_t acc = _error[channel] + ( level & 0xff );
+		_error[channel] = acc;				// low byte is carried to the next frame
+		uint16_t out = ( level >> 8 ) + ( acc >> 8 );
+		return ( out > 255 ) ? 255 : out;
+	}
+
+/*!
+* @brief dither count channels starting with channel 0
+* @param src 16 bit levels
+* @param dst 8 bit outputs
+*/
+	void     process  ( const uint16_t* src, uint8_t* dst, uint16_t count );
+
+/*!
+* @brief clear accumulated error
+*/
+	void     reset    ( void );
+
+  private:
+	uint8_t*  _error;
+	uint16_t  _channels;
+/// _error was allocated with malloc
+	uint8_t   _owns_error;
+};
+
+#endif // ifndef LXDMXDITHER_H
@@ -0,0 +1,16 @@
+/* LXDMXEthernet.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXEthernet.h"
+
+int LXDMXEthernet::slotRangeCount ( int start, int count ) {
+	if (( start < 1 ) || ( start > DMX_UNIVERSE_SIZE ) || ( count <= 0 )) {
+		return 0;
+	}
+	if ( count > DMX_UNIVERSE_SIZE + 1 - start ) {
+		return DMX_UNIVERSE_SIZE + 1 - start;
+	}
+	return count;
+}
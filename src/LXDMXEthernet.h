@@ -34,6 +34,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Arduino.h>
 #include <inttypes.h>
+#include "LXDMXCounters.h"
+#include "LXDMXLatency.h"
+#include "LXDMXUniverseStore.h"
+#include "LXDMXArena.h"
 
 #define RESULT_NONE 0
 #define RESULT_DMX_RECEIVED 1
@@ -47,6 +51,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	#define INADDR_NONE IPAddress(0, 0, 0, 0)
 #endif
 
+/*!
+* @brief contiguous view of a universe's slots
+* @discussion slots[0] is slot start, 1 unless a slot window is set.  Valid until the next packet is read.
+*/
+typedef struct {
+/// pointer to first slot
+	uint8_t* slots;
+/// number of slots
+	uint16_t count;
+/// slot number (1-512) of slots[0]
+	uint16_t start;
+} LXDMXSpan;
+
+/*!
+* @brief function called when DMX data for a universe is received
+* @param universe Art-Net port-address (net<<8 | subnet/universe) or sACN universe
+* @param data pointer to slot 1, or the first slot of the window set by setSlotWindow (merged data if HTP is enabled)
+* @param slots number of slots in data
+* @param first_changed first slot (1-512, not relative to the window) that changed, zero if none
+* @param last_changed last slot that changed, zero if none
+* @discussion Without HTP the previous data is not kept so all slots are reported as changed.
+*/
+typedef void (*LXDMXReceivedCallback)(uint16_t universe, uint8_t* data, uint16_t slots, uint16_t first_changed, uint16_t last_changed);
+
 /*!   
 @class LXDMXEthernet
 @abstract
@@ -97,6 +125,18 @@ class LXDMXEthernet {
                          ATmega328P due to RAM size.
  */
    virtual void    enableHTP     ( void );
+/*!
+ * @brief receive only slots start to start+len-1
+ * @discussion Call before enableHTP(), the HTP buffers are then len bytes each instead of 512.
+ *             Slots outside the window are not merged, getHTPSlot() returns zero for them.
+ *             The callback, universeSpan() and a universe store get only the window.
+ *             Without HTP the packet buffer is unchanged, only the end of the window is cleared
+ *             when a short packet is received.
+ * @param start first slot 1-512
+ * @param len number of slots
+ * @return 1 if set, 0 if HTP is already enabled or start is invalid
+ */
+   virtual uint8_t setSlotWindow ( uint16_t start, uint16_t len );
  
  /*!
  * @brief number of slots (aka addresses or channels)
@@ -134,6 +174,28 @@ class LXDMXEthernet {
  * @return uint8_t* to dmx data buffer
  */  
    virtual uint8_t* dmxData      ( void );
+ /*!
+ * @brief copy levels of consecutive slots
+ * @discussion Reads the packet data like getSlot().  Range is limited to slots 1-512.
+ * @param start first slot 1 to 512
+ * @param count number of slots
+ * @param dst array of at least count bytes
+ */  
+   virtual void     getSlots     ( int start, int count, uint8_t* dst );
+ /*!
+ * @brief set levels of consecutive slots
+ * @discussion Range is limited to slots 1-512.
+ * @param start first slot 1 to 512
+ * @param count number of slots
+ * @param src array of at least count levels
+ */  
+   virtual void     setSlots     ( int start, int count, const uint8_t* src );
+ /*!
+ * @brief view of received universe
+ * @discussion merged HTP data if enableHTP() has been called, otherwise the packet data
+ * @return LXDMXSpan with pointer to slot 1 and number of slots
+ */  
+   virtual LXDMXSpan universeSpan ( void );
 
  /*!
  * @brief read UDP packet
@@ -154,6 +216,50 @@ class LXDMXEthernet {
  * @brief send the contents of the _packet_buffer to the address to_ip
  */
    virtual void    sendDMX       ( UDP* eUDP, IPAddress to_ip );
+   
+/*!
+ * @brief copy snapshot of traffic counters
+ * @discussion all zero if the library is built with LXDMX_COUNTERS_ENABLED 0
+ * @param c pointer to LXDMXCounters to receive snapshot
+ */
+   virtual void    getCounters   ( LXDMXCounters* c );
+   
+/*!
+ * @brief zero traffic counters
+ */
+   virtual void    resetCounters ( void );
+   
+/*!
+ * @brief time the current DMX data was received
+ * @return micros() when last DMX packet was accepted
+ */
+   virtual uint32_t dmxReceivedTime   ( void );
+   
+/*!
+ * @brief set monitor to record arrival of each accepted DMX packet
+ * @param monitor LXDMXLatency for this universe or NULL
+ */
+   virtual void     setLatencyMonitor ( LXDMXLatency* monitor );
+   
+/*!
+ * @brief set function called when DMX data for this universe is received
+ * @param callback LXDMXReceivedCallback or NULL
+ */
+   virtual void     setDMXReceivedCallback ( LXDMXReceivedCallback callback );
+   
+/*!
+ * @brief copy each DMX packet accepted to a universe of a shared store
+ * @param store LXDMXUniverseStore or NULL
+ * @param index universe index in store
+ */
+   virtual void     setUniverseStore ( LXDMXUniverseStore* store, uint8_t index );
+   
+/*!
+ * @brief number of slots from start to copy, limited to the universe
+ * @discussion used by getSlots/setSlots here and in LXDMXNode
+ * @return count limited so that start+count-1 <= 512, zero if start is not 1-512
+ */
+   static int      slotRangeCount  ( int start, int count );
 };
 
 #endif // ifndef LXDMXETHERNET_H
@@ -0,0 +1,53 @@
+/* LXDMXFineChannels.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXFineChannels.h"
+
+LXDMXFineChannels::LXDMXFineChannels ( void ) {
+	clear();
+}
+
+LXDMXFineChannels::~LXDMXFineChannels ( void ) {
+}
+
+uint8_t LXDMXFineChannels::addPair ( uint16_t coarse, uint16_t fine ) {
+	if (( _count >= LXDMX_FINE_MAX_PAIRS ) ||
+	    ( coarse < 1 ) || ( coarse > DMX_UNIVERSE_SIZE ) || ( fine < 1 ) || ( fine > DMX_UNIVERSE_SIZE )) {
+		return LXDMX_FINE_INVALID;
+	}
+	_coarse[_count] = coarse;
+	_fine[_count] = fine;
+	return _count++;
+}
+
+void LXDMXFineChannels::clear ( void ) {
+	_count = 0;
+}
+
+uint8_t LXDMXFineChannels::count ( void ) {
+	return _count;
+}
+
+uint16_t LXDMXFineChannels::value ( uint8_t index, const uint8_t* data, uint16_t slots ) {
+	if ( index >= _count ) {
+		return 0;
+	}
+	return ( level(data, slots, 1, _coarse[index]) << 8 ) | level(data, slots, 1, _fine[index]);
+}
+
+void LXDMXFineChannels::readSpan ( LXDMXSpan span, uint16_t* dst ) {
+	for (uint8_t i=0; i<_count; i++) {
+		dst[i] = ( level(span.slots, span.count, span.start, _coarse[i]) << 8 )
+		         | level(span.slots, span.count, span.start, _fine[i]);
+	}
+}
+
+uint8_t LXDMXFineChannels::level ( const uint8_t* data, uint16_t slots, uint16_t first, uint16_t slot ) {
+	uint16_t i = slot - first;				// wraps if slot < first
+	if ( i < slots ) {
+		return data[i];
+	}
+	return 0;
+}
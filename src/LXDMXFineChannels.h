@@ -0,0 +1,85 @@
+/* LXDMXFineChannels.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXFINECHANNELS_H
+#define LXDMXFINECHANNELS_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include "LXDMXEthernet.h"
+
+// maximum number of 16 bit channels
+#define LXDMX_FINE_MAX_PAIRS 32
+// returned by addPair when full or slots are invalid
+#define LXDMX_FINE_INVALID 0xff
+
+/*!
+@class LXDMXFineChannels
+@abstract
+   LXDMXFineChannels reads 16 bit values from coarse/fine slot pairs in a universe.
+
+   Declare each pair with addPair(coarse, fine), usually fine = coarse + 1,
+   then read values from received data.  value = coarse << 8 | fine.
+
+   LXDMXFineChannels fine;
+   uint8_t pan = fine.addPair(1, 2);
+   uint8_t tilt = fine.addPair(3, 4);
+   ...
+   uint16_t p = fine.value(pan, data, slots);
+*/
+class LXDMXFineChannels {
+
+  public:
+	LXDMXFineChannels ( void );
+   ~LXDMXFineChannels ( void );
+
+/*!
+* @brief declare a 16 bit channel
+* @param coarse slot 1-512 of the high byte
+* @param fine slot 1-512 of the low byte
+* @return index of channel, LXDMX_FINE_INVALID if full or a slot is out of range
+*/
+	uint8_t  addPair   ( uint16_t coarse, uint16_t fine );
+/*!
+* @brief remove all channels
+*/
+	void     clear     ( void );
+	uint8_t  count     ( void );
+
+/*!
+* @brief 16 bit value of a channel
+* @param index from addPair
+* @param data pointer to slot 1
+* @param slots number of slots in data, a slot not received reads as zero
+*/
+	uint16_t value     ( uint8_t index, const uint8_t* data, uint16_t slots );
+
+/*!
+* @brief read all channels
+* @param span from universeSpan(), may be a slot window
+* @param dst array of count() values
+*/
+	void     readSpan  ( LXDMXSpan span, uint16_t* dst );
+
+/*!
+* @brief 16 bit value of slot and slot+1
+* @param data pointer to slot 1
+*/
+	static uint16_t value16 ( const uint8_t* data, uint16_t slot ) {
+		return ( data[slot-1] << 8 ) | data[slot];
+	}
+
+  private:
+	uint16_t _coarse[LXDMX_FINE_MAX_PAIRS];
+	uint16_t _fine[LXDMX_FINE_MAX_PAIRS];
+	uint8_t  _count;
+
+/*!
+* @brief level of slot in data starting with slot first, zero if outside
+*/
+	uint8_t  level     ( const uint8_t* data, uint16_t slots, uint16_t first, uint16_t slot );
+};
+
+#endif // ifndef LXDMXFINECHANNELS_H
@@ -0,0 +1,157 @@
+/* LXDMXFrameScheduler.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXDMXFrameScheduler has no dependencies on Arduino other than the critical
+   section from LXDMXTripleBuffer.h.  Times are passed in so it can also be
+   compiled on a host with a simulated UART.
+*/
+
+#ifndef LXDMXFRAMESCHEDULER_H
+#define LXDMXFRAMESCHEDULER_H
+
+#include <inttypes.h>
+#include "LXDMXTripleBuffer.h"
+
+// E1.11 minimum time from the start of one break to the next for a transmitter, microseconds
+#define LXDMX_MIN_BREAK_TO_BREAK 1204
+// default time a frame is repeated when nothing new arrives, microseconds
+#define LXDMX_KEEP_ALIVE_INTERVAL 100000
+
+/*!
+@class LXDMXFrameScheduler
+@abstract
+   LXDMXFrameScheduler decides when a DMX output driver starts a frame
+   so that new data goes out as soon as it arrives instead of waiting for a
+   free running frame to finish.
+
+   When the loop has a new frame (for example after a packet is received and
+   publishFrame() is called) it calls trigger().  At the end of each frame
+   the TX ISR calls frameComplete().  If a trigger is waiting and the minimum
+   break to break time has passed the next frame starts immediately, otherwise
+   the driver goes idle with the line marking.  The loop calls service(), which
+   starts a frame from idle as soon as a trigger is allowed or when the
+   keep alive interval has passed without one.
+
+   frameComplete() is only called by the ISR while sending and service() only
+   acts while idle, so the two do not conflict.
+*/
+class LXDMXFrameScheduler {
+
+  public:
+	LXDMXFrameScheduler ( void ) {
+		_min_break_to_break = LXDMX_MIN_BREAK_TO_BREAK;
+		_keep_alive = LXDMX_KEEP_ALIVE_INTERVAL;
+		_last_break = 0;
+		_pending = 0;
+		_sending = 0;
+		_frames = 0;
+		_triggered_frames = 0;
+	}
+
+/*!
+* @brief minimum time between starts of frames
+* @param us microseconds, not less than LXDMX_MIN_BREAK_TO_BREAK
+*/
+	void setMinBreakToBreak ( uint32_t us ) {
+		_min_break_to_break = ( us < LXDMX_MIN_BREAK_TO_BREAK ) ? LXDMX_MIN_BREAK_TO_BREAK : us;
+	}
+/*!
+* @brief time after which the last frame is sent again if there is no trigger
+* @param us microseconds
+*/
+	void setKeepAlive ( uint32_t us ) {
+		_keep_alive = us;
+	}
+
+/*!
+* @brief new data is ready to send
+*/
+	void trigger ( void ) {
+		_pending = 1;
+	}
+
+/*!
+* @brief called by the TX ISR after the last slot of a frame
+* @param now micros()
+* @return 1 to send the next break now, 0 to go idle
+*/
+	uint8_t frameComplete ( uint32_t now ) {
+		if ( _pending && (( now - _last_break ) >= _min_break_to_break )) {
+			start(now);
+			return 1;
+		}
+		_sending = 0;
+		return 0;
+	}
+
+/*!
+* @brief called from loop
+* @param now micros()
+* @return 1 if the driver is idle and should send a break now
+*/
+	uint8_t service ( uint32_t now ) {
+		if ( _sending ) {
+			return 0;
+		}
+		uint32_t elapsed = now - _last_break;
+		if (( _pending && ( elapsed >= _min_break_to_break )) || ( elapsed >= _keep_alive )) {
+			start(now);
+			return 1;
+		}
+		return 0;
+	}
+
+/*!
+* @brief a frame is being sent
+*/
+	uint8_t sending ( void ) {
+		return _sending;
+	}
+
+/*!
+* @brief called when output starts, the first frameComplete() starts a frame
+*/
+	void begin ( uint32_t now ) {
+		_pending = 1;
+		_sending = 1;
+		_last_break = now - _min_break_to_break;
+	}
+
+/*!
+* @brief frames started, triggered frames started
+* @discussion counts are incremented by the TX ISR, read with interrupts off
+*/
+	uint32_t frames          ( void ) { return read32(&_frames); }
+	uint32_t triggeredFrames ( void ) { return read32(&_triggered_frames); }
+
+  private:
+	uint32_t _min_break_to_break;
+	uint32_t _keep_alive;
+/// micros() at start of most recent break
+	volatile uint32_t _last_break;
+	volatile uint8_t  _pending;
+	volatile uint8_t  _sending;
+	volatile uint32_t _frames;
+	volatile uint32_t _triggered_frames;
+
+	void start ( uint32_t now ) {
+		if ( _pending ) {
+			_triggered_frames++;
+		}
+		_pending = 0;
+		_sending = 1;
+		_last_break = now;
+		_frames++;
+	}
+
+/// copy of a count the ISR may be changing, 32 bit reads are not atomic on AVR
+	uint32_t read32 ( volatile uint32_t* v ) {
+		LXDMX_CRITICAL_BEGIN
+		uint32_t n = *v;
+		LXDMX_CRITICAL_END
+		return n;
+	}
+};
+
+#endif // ifndef LXDMXFRAMESCHEDULER_H
@@ -0,0 +1,175 @@
+/* LXDMXInputStats.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXDMXInputStats has no dependencies on Arduino other than the critical
+   section from LXDMXTripleBuffer.h so it can also be compiled on a host
+   with a simulated ISR.
+*/
+
+#ifndef LXDMXINPUTSTATS_H
+#define LXDMXINPUTSTATS_H
+
+#include <inttypes.h>
+#include "LXDMXTripleBuffer.h"
+
+// E1.11 minimum break to break time for a receiver, microseconds
+#define LXDMX_RX_MIN_BREAK_TO_BREAK 1196
+
+/*!
+@class LXDMXInputStats
+@abstract
+   LXDMXInputStats counts what a DMX receive ISR sees on the line so that a bad
+   input can be diagnosed and incomplete frames are not passed on.
+
+   The ISR calls breakReceived() when a framing error with a zero byte is read
+   (a break), startCode() for the first byte after a break and framingError()
+   for a framing error on any other byte.
+
+   A frame is counted on the break that ends it.  It is valid if it had a null
+   start code, at least one slot, no framing error and was not shorter than the
+   minimum break to break time.  lastFrameValid() refers to the frame most
+   recently completed, the one published to the loop on that break.
+
+   The UART only reports complete bytes, so the length of the break and mark
+   after break cannot be measured.  breakToBreak() is timed from the framing
+   error of each break.
+*/
+class LXDMXInputStats {
+
+  public:
+	LXDMXInputStats ( void ) {
+		reset();
+	}
+
+/*!
+* @brief clear counts
+*/
+	void reset ( void ) {
+		LXDMX_CRITICAL_BEGIN
+		_frames = 0;
+		_framing_errors = 0;
+		_short_frames = 0;
+		_alternate_start_codes = 0;
+		_last_break = 0;
+		_break_to_break = 0;
+		_slots = 0;
+		_timed = 0;
+		_error = 0;
+		_valid = 0;
+		LXDMX_CRITICAL_END
+	}
+
+/*!
+* @brief called by the ISR on a break
+* @param now micros()
+* @param slots start code plus slots received since the previous break, 0 if no DMX frame
+*/
+	void breakReceived ( uint32_t now, uint16_t slots ) {
+		uint32_t period = now - _last_break;
+		uint8_t timed = _timed;
+		_last_break = now;
+		_timed = 1;
+		if ( slots > 0 ) {
+			uint8_t valid = ! _error;
+			_frames++;
+			_slots = slots - 1;
+			if ( timed ) {
+				_break_to_break = period;
+			}
+			if (( slots < 2 ) || ( timed && ( period < LXDMX_RX_MIN_BREAK_TO_BREAK ))) {
+				_short_frames++;
+				valid = 0;
+			}
+			_valid = valid;
+		}
+		_error = 0;
+	}
+
+/*!
+* @brief called by the ISR with the first byte after a break
+*/
+	void startCode ( uint8_t code ) {
+		if ( code != 0 ) {
+			_alternate_start_codes++;
+		}
+	}
+
+/*!
+* @brief called by the ISR on a framing error that is not a break
+*/
+	void framingError ( void ) {
+		_framing_errors++;
+		_error = 1;
+	}
+
+/*!
+* @brief DMX (null start code) frames received
+*/
+	uint32_t frames ( void ) {
+		return read32(&_frames);
+	}
+/*!
+* @brief framing errors other than breaks
+*/
+	uint32_t framingErrors ( void ) {
+		return read32(&_framing_errors);
+	}
+/*!
+* @brief frames with no slots or less than the minimum break to break time
+*/
+	uint32_t shortFrames ( void ) {
+		return read32(&_short_frames);
+	}
+/*!
+* @brief packets with a start code other than zero (RDM, text, system information...)
+*/
+	uint32_t alternateStartCodes ( void ) {
+		return read32(&_alternate_start_codes);
+	}
+/*!
+* @brief microseconds between the breaks of the last frame
+*/
+	uint32_t breakToBreak ( void ) {
+		return read32(&_break_to_break);
+	}
+/*!
+* @brief slots in the last frame, not including the start code
+*/
+	uint16_t slots ( void ) {
+		LXDMX_CRITICAL_BEGIN
+		uint16_t n = _slots;
+		LXDMX_CRITICAL_END
+		return n;
+	}
+/*!
+* @brief 1 if the last frame was complete and had no errors
+*/
+	uint8_t lastFrameValid ( void ) {
+		return _valid;
+	}
+
+  private:
+	volatile uint32_t _frames;
+	volatile uint32_t _framing_errors;
+	volatile uint32_t _short_frames;
+	volatile uint32_t _alternate_start_codes;
+/// micros() at most recent break
+	volatile uint32_t _last_break;
+	volatile uint32_t _break_to_break;
+	volatile uint16_t _slots;
+/// _last_break has been set
+	volatile uint8_t  _timed;
+/// framing error since last break
+	volatile uint8_t  _error;
+	volatile uint8_t  _valid;
+
+	uint32_t read32 ( volatile uint32_t* v ) {
+		LXDMX_CRITICAL_BEGIN
+		uint32_t n = *v;
+		LXDMX_CRITICAL_END
+		return n;
+	}
+};
+
+#endif // ifndef LXDMXINPUTSTATS_H
@@ -0,0 +1,124 @@
+/* LXDMXInterpolator.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXInterpolator.h"
+#include <stdlib.h>
+#include <string.h>
+
+LXDMXInterpolator::LXDMXInterpolator ( uint16_t slots ) {
+	_previous = (uint8_t*) malloc(slots);
+	_current = (uint8_t*) malloc(slots);
+	_owns_buffers = 1;
+	_slots = slots;
+	initialize();
+}
+
+LXDMXInterpolator::LXDMXInterpolator ( uint16_t slots, LXDMXArena* arena ) {
+	_previous = arena->allocate(slots);
+	_current = arena->allocate(slots);
+	_owns_buffers = 0;
+	_slots = slots;
+	initialize();
+}
+
+LXDMXInterpolator::~LXDMXInterpolator ( void ) {
+	if ( _owns_buffers ) {
+		free(_previous);		// free(NULL) does nothing
+		free(_current);
+	}
+}
+
+void LXDMXInterpolator::initialize ( void ) {
+	if (( _previous == NULL ) || ( _current == NULL )) {
+		_slots = 0;
+	} else {
+		memset(_previous, 0, _slots);
+		memset(_current, 0, _slots);
+	}
+	_received = 0;
+	_interval = LXDMX_INTERP_DEFAULT_INTERVAL;
+	_has_frame = 0;
+}
+
+uint16_t LXDMXInterpolator::numberOfSlots ( void ) {
+	return _slots;
+}
+
+uint32_t LXDMXInterpolator::interval ( void ) {
+	return _interval;
+}
+
+void LXDMXInterpolator::frameReceived ( const uint8_t* data, uint16_t slots, uint32_t received ) {
+	if ( slots > _slots ) {
+		slots = _slots;
+	}
+	if ( _has_frame ) {
+		uint32_t pos = position(received);		// before the interval changes
+		uint32_t elapsed = received - _received;
+		if (( elapsed >= LXDMX_INTERP_MIN_INTERVAL ) && ( elapsed <= LXDMX_INTERP_MAX_INTERVAL )) {
+			// exponential moving average, 1/8 weight to the new interval
+			_interval = _interval - ( _interval >> 3 ) + ( elapsed >> 3 );
+		}
+
+		uint8_t* t = _previous;				// previous frame is replaced
+		_previous = _current;
+		_current = t;
+		if ( pos < 0x10000 ) {					// fade incomplete, start from current output
+			for (uint16_t i=0; i<_slots; i++) {
+				int16_t d = _previous[i] - _current[i];		// _current holds the older frame
+				_previous[i] = _current[i] + (( d * (int32_t)pos ) >> 16 );
+			}
+		}
+	}
+	memcpy(_current, data, slots);
+	if ( slots < _slots ) {
+		memset(&_current[slots], 0, _slots - slots);
+	}
+	if ( ! _has_frame ) {
+		memcpy(_previous, _current, _slots);
+		_has_frame = 1;
+	}
+	_received = received;
+}
+
+uint32_t LXDMXInterpolator::position ( uint32_t now ) {
+	uint32_t elapsed = now - _received;
+	if ( elapsed >= _interval ) {
+		return 0x10000;
+	}
+	// elapsed < _interval <= LXDMX_INTERP_MAX_INTERVAL fits in 17 bits, shift 15 to stay within 32
+	return (( elapsed << 15 ) / _interval ) << 1;
+}
+
+void LXDMXInterpolator::frame ( uint8_t* dst, uint16_t count, uint32_t now ) {
+	if ( count > _slots ) {
+		count = _slots;
+	}
+	uint32_t pos = position(now);
+	if ( pos >= 0x10000 ) {
+		memcpy(dst, _current, count);
+		return;
+	}
+	int32_t p = pos;
+	for (uint16_t i=0; i<count; i++) {
+		int16_t d = _current[i] - _previous[i];
+		dst[i] = _previous[i] + (( d * p ) >> 16 );
+	}
+}
+
+void LXDMXInterpolator::frame16 ( uint16_t* dst, uint16_t count, uint32_t now ) {
+	if ( count > _slots ) {
+		count = _slots;
+	}
+	uint32_t pos = position(now);
+	if ( pos > 0x10000 ) {
+		pos = 0x10000;
+	}
+	int32_t p = pos;
+	for (uint16_t i=0; i<count; i++) {
+		int16_t d = _current[i] - _previous[i];
+		dst[i] = ( _previous[i] << 8 ) + (( d * p ) >> 8 );
+	}
+}
@@ -0,0 +1,107 @@
+/* LXDMXInterpolator.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXINTERPOLATOR_H
+#define LXDMXINTERPOLATOR_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include "LXDMXArena.h"
+
+// starting estimate of time between frames, microseconds (44Hz)
+#define LXDMX_INTERP_DEFAULT_INTERVAL 22727
+// longer gaps (source paused) are not used to update the estimate
+#define LXDMX_INTERP_MAX_INTERVAL 100000
+#define LXDMX_INTERP_MIN_INTERVAL 1000
+
+// LXDMXArena bytes used by an LXDMXInterpolator of n slots
+#define LXDMX_INTERP_ARENA_BYTES(n) (2 * LXDMX_ARENA_ALIGNED(n))
+
+/*!
+@class LXDMXInterpolator
+@abstract
+   LXDMXInterpolator outputs frames at a higher rate than DMX is received by
+   fading linearly from the previous to the most recent frame.
+
+   frameReceived() is called with each received frame (dmxData(), universeSpan()
+   or from an LXDMXReceivedCallback) and its micros() timestamp.  The time between
+   frames is measured and averaged.  frame() then returns the levels at any time,
+   reaching the received frame one average interval after it arrived.
+   If a frame arrives before the fade is complete, the fade continues from the
+   current output level so there is no jump.
+
+   Interpolation is fixed point: the position in the fade is 0-65536 (Q16) and
+   each slot is prev + ((current - prev) * position >> 16).
+   The output is delayed by one frame interval compared to the received data.
+*/
+class LXDMXInterpolator {
+
+  public:
+/*!
+* @brief constructor allocates two frames of slots
+*/
+	LXDMXInterpolator ( uint16_t slots );
+/*!
+* @brief constructor takes frames from an arena
+* @param arena LXDMXArena with LXDMX_INTERP_ARENA_BYTES(slots) remaining
+*/
+	LXDMXInterpolator ( uint16_t slots, LXDMXArena* arena );
+   ~LXDMXInterpolator ( void );
+
+/*!
+* @brief number of slots, zero if allocation failed
+*/
+	uint16_t numberOfSlots ( void );
+
+/*!
+* @brief start fading to a new frame
+* @param data pointer to first slot
+* @param slots number of slots in data, slots not received are zero
+* @param received micros() when the frame was received
+*/
+	void     frameReceived ( const uint8_t* data, uint16_t slots, uint32_t received );
+
+/*!
+* @brief position in current fade
+* @param now micros()
+* @return 0 (previous frame) to 65536 (current frame)
+*/
+	uint32_t position      ( uint32_t now );
+
+/*!
+* @brief interpolated levels
+* @param dst array of count levels
+* @param count number of slots
+* @param now micros()
+*/
+	void     frame         ( uint8_t* dst, uint16_t count, uint32_t now );
+/*!
+* @brief interpolated levels with 8 bits of fraction (for LXDMXDither or 16 bit outputs)
+*/
+	void     frame16       ( uint16_t* dst, uint16_t count, uint32_t now );
+
+/*!
+* @brief average time between frames in microseconds
+*/
+	uint32_t interval      ( void );
+
+  private:
+	uint8_t*  _previous;
+	uint8_t*  _current;
+	uint16_t  _slots;
+/// micros() of most recent frame
+	uint32_t  _received;
+	uint32_t  _interval;
+	uint8_t   _has_frame;
+/// buffers were allocated with malloc
+	uint8_t   _owns_buffers;
+
+/*!
+* @brief initialize after buffers are allocated
+*/
+	void      initialize    ( void );
+};
+
+#endif // ifndef LXDMXINTERPOLATOR_H
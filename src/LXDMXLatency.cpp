@@ -0,0 +1,97 @@
+/* LXDMXLatency.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXDMXLatency keeps histograms of receive to output latency
+   and packet inter-arrival time for one universe.
+*/
+
+#include "LXDMXLatency.h"
+
+LXDMXLatency::LXDMXLatency ( void ) {
+	reset();
+}
+
+LXDMXLatency::~LXDMXLatency ( void ) {
+}
+
+void LXDMXLatency::packetReceived ( uint32_t received ) {
+	if ( _last_received != 0 ) {
+		uint32_t interval = received - _last_received;
+		record(_interval, interval);
+		_interval_count++;
+
+		if ( _interval_count > 1 ) {
+			// J = J + (|D| - J)/16  kept scaled by 16
+			uint32_t d = ( interval > _last_interval ) ? interval - _last_interval : _last_interval - interval;
+			_jitter16 = _jitter16 + d - ( _jitter16 >> 4 );
+		}
+		_last_interval = interval;
+	}
+	_last_received = received;
+}
+
+void LXDMXLatency::outputComplete ( uint32_t received ) {
+	record(_latency, micros() - received);
+	_latency_count++;
+}
+
+uint32_t LXDMXLatency::latencyPercentile ( uint8_t percent ) {
+	return percentile(_latency, _latency_count, percent);
+}
+
+uint32_t LXDMXLatency::intervalPercentile ( uint8_t percent ) {
+	return percentile(_interval, _interval_count, percent);
+}
+
+uint32_t LXDMXLatency::jitter ( void ) {
+	return _jitter16 >> 4;
+}
+
+uint32_t LXDMXLatency::latencySamples ( void ) {
+	return _latency_count;
+}
+
+uint32_t LXDMXLatency::intervalSamples ( void ) {
+	return _interval_count;
+}
+
+void LXDMXLatency::reset ( void ) {
+	memset(_latency, 0, sizeof(_latency));
+	memset(_interval, 0, sizeof(_interval));
+	_latency_count = 0;
+	_interval_count = 0;
+	_last_received = 0;
+	_last_interval = 0;
+	_jitter16 = 0;
+}
+
+void LXDMXLatency::record ( uint32_t* histogram, uint32_t us ) {
+	uint8_t b = 0;
+	while (( us > 1 ) && ( b < LXDMX_LATENCY_BUCKETS-1 )) {
+		us >>= 1;
+		b++;
+	}
+	histogram[b]++;
+}
+
+uint32_t LXDMXLatency::percentile ( uint32_t* histogram, uint32_t count, uint8_t percent ) {
+	if ( count == 0 ) {
+		return 0;
+	}
+	uint32_t target = ( (uint64_t)count * percent + 99 ) / 100;	// rank of sample, rounded up
+	if ( target == 0 ) {
+		target = 1;
+	}
+	uint32_t seen = 0;
+	for ( uint8_t b=0; b<LXDMX_LATENCY_BUCKETS; b++ ) {
+		if ( histogram[b] && (( seen + histogram[b] ) >= target )) {
+			uint32_t low = ( b == 0 ) ? 0 : ( 1UL << b );
+			uint32_t width = ( b == 0 ) ? 2 : ( 1UL << b );
+			// interpolate within bucket
+			return low + (uint32_t)(( (uint64_t)width * ( target - seen )) / histogram[b] );
+		}
+		seen += histogram[b];
+	}
+	return 1UL << ( LXDMX_LATENCY_BUCKETS - 1 );
+}
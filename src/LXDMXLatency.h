@@ -0,0 +1,109 @@
+/* LXDMXLatency.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXLATENCY_H
+#define LXDMXLATENCY_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+
+// bucket n of a histogram holds times from 2^n to 2^(n+1)-1 microseconds (bucket 0 includes 0)
+#define LXDMX_LATENCY_BUCKETS 24
+
+/*!
+@class LXDMXLatency
+@abstract
+   LXDMXLatency measures one universe's timing from packet receipt to output.
+
+   The receiver calls packetReceived() with the micros() timestamp of each accepted
+   DMX packet, recording the inter-arrival time.  Attach to LXArtNet or LXSACN
+   with setLatencyMonitor() and this happens automatically.
+
+   The consumer calls outputComplete() with the receiver's dmxReceivedTime()
+   after the data has been written to its output (DMX USART, pixels...),
+   recording the latency from the wire to the output.
+
+   Times are kept in power of two histograms so percentiles are approximate
+   (within the bucket, linearly interpolated).  Jitter is the running mean of the
+   difference between successive inter-arrival times (as RFC 3550).
+*/
+class LXDMXLatency {
+
+  public:
+	LXDMXLatency ( void );
+   ~LXDMXLatency ( void );
+
+/*!
+* @brief record arrival of a DMX packet
+* @param received micros() when packet was accepted
+*/
+	void     packetReceived ( uint32_t received );
+
+/*!
+* @brief record that data received at time received has reached the output
+* @param received micros() when packet was accepted, see dmxReceivedTime()
+*/
+	void     outputComplete ( uint32_t received );
+
+/*!
+* @brief latency from receipt to output
+* @param percent percentile 1-100 (50 for median, 99...)
+* @return microseconds, zero if no samples
+*/
+	uint32_t latencyPercentile  ( uint8_t percent );
+
+/*!
+* @brief time between packets
+* @param percent percentile 1-100
+* @return microseconds, zero if no samples
+*/
+	uint32_t intervalPercentile ( uint8_t percent );
+
+/*!
+* @brief running mean variation in inter-arrival time
+* @return microseconds
+*/
+	uint32_t jitter ( void );
+
+/*!
+* @brief number of latency samples recorded
+*/
+	uint32_t latencySamples  ( void );
+
+/*!
+* @brief number of inter-arrival samples recorded
+*/
+	uint32_t intervalSamples ( void );
+
+/*!
+* @brief clear histograms and jitter
+*/
+	void     reset ( void );
+
+  private:
+/// latency histogram
+	uint32_t _latency[LXDMX_LATENCY_BUCKETS];
+/// inter-arrival histogram
+	uint32_t _interval[LXDMX_LATENCY_BUCKETS];
+	uint32_t _latency_count;
+	uint32_t _interval_count;
+/// timestamp of previous packet
+	uint32_t _last_received;
+/// previous inter-arrival time
+	uint32_t _last_interval;
+/// jitter scaled by 16
+	uint32_t _jitter16;
+
+/*!
+* @brief add sample to histogram
+*/
+	void     record     ( uint32_t* histogram, uint32_t us );
+/*!
+* @brief estimate percentile from histogram
+*/
+	uint32_t percentile ( uint32_t* histogram, uint32_t count, uint8_t percent );
+};
+
+#endif // ifndef LXDMXLATENCY_H
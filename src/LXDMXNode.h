@@ -0,0 +1,190 @@
+/* LXDMXNode.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXNODE_H
+#define LXDMXNODE_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include <string.h>
+#include "LXDMXEthernet.h"
+#include "LXArtNet.h"
+#include "LXSACN.h"
+
+/*!
+* @brief compile time constants for each protocol
+* @discussion address_offset + n is the index of slot n in the packet buffer.
+*/
+template <class P> struct LXDMXProtocolTraits;
+
+template <> struct LXDMXProtocolTraits<LXArtNet> {
+	enum { address_offset = ARTNET_ADDRESS_OFFSET, port = ARTNET_PORT, buffer_size = ARTNET_BUFFER_MAX };
+};
+
+template <> struct LXDMXProtocolTraits<LXSACN> {
+	enum { address_offset = SACN_ADDRESS_OFFSET, port = SACN_PORT, buffer_size = SACN_BUFFER_MAX };
+};
+
+/*!
+@class LXDMXNode
+@abstract
+   LXDMXNode<LXArtNet> or LXDMXNode<LXSACN> is a front end to a protocol object
+   for sketches that know their protocol when compiled.
+
+   Slot accessors are inline with the buffer offset a constant, so a loop over
+   getSlot() compiles to indexed reads instead of a virtual call per slot.
+   Other calls name the protocol's own method (P::method) so they are bound
+   when compiled rather than through the LXDMXEthernet vtable.
+
+   LXDMXNode only uses the public API of the protocol class.  The protocol
+   logic stays in LXArtNet and LXSACN and LXDMXNode is a front end over them.
+   Making a template core with the virtual classes as adapters would change
+   both classes throughout and the API that existing sketches use, for the
+   same gain in the slot accessors, which are the only per slot calls.
+
+   The protocol object is unchanged and still used for everything else
+   (configuration, polls, RDM...) through protocol() or the LXDMXEthernet* API.
+
+   The slot accessors behave as the protocol's own: if the protocol has no packet
+   buffer (its arena was too small) getSlot() returns 0 and writes are ignored, and
+   getSlots()/setSlots() are limited to the universe with slotRangeCount().
+   The buffer is looked up once when the node is constructed.
+
+   LXArtNet artnet(Ethernet.localIP(), Ethernet.subnetMask());
+   LXDMXNode<LXArtNet> node(artnet);
+   if ( node.readDMXPacket(&eUDP) == RESULT_DMX_RECEIVED ) {
+      analogWrite(3, node.getSlot(1));
+   }
+*/
+template <class P>
+class LXDMXNode {
+
+  public:
+	LXDMXNode ( P& protocol ) : _protocol(protocol) {
+		_buffer = _protocol.packetBuffer();
+		if ( _buffer != NULL ) {
+			_buffer += LXDMXProtocolTraits<P>::address_offset;	// _buffer[n] is slot n
+		}
+	}
+
+/*!
+* @brief the wrapped LXArtNet or LXSACN object
+*/
+	P& protocol ( void ) { return _protocol; }
+
+/*!
+* @brief UDP port used by protocol
+*/
+	static uint16_t dmxPort ( void ) { return LXDMXProtocolTraits<P>::port; }
+
+/*!
+* @brief read UDP packet (non-virtual call to protocol)
+* @return RESULT_DMX_RECEIVED if packet contains dmx
+*/
+	uint8_t readDMXPacket ( UDP* eUDP ) {
+		return _protocol.P::readDMXPacket(eUDP);
+	}
+
+/*!
+* @brief read contents of packet already in the packet buffer (non-virtual call to protocol)
+* @return RESULT_DMX_RECEIVED if packet contains dmx
+*/
+	uint8_t readDMXPacketContents ( UDP* eUDP, int packetSize ) {
+		return _protocol.P::readDMXPacketContents(eUDP, packetSize);
+	}
+
+/*!
+* @brief send the contents of the packet buffer (non-virtual call to protocol)
+*/
+	void sendDMX ( UDP* eUDP, IPAddress to_ip ) {
+		_protocol.P::sendDMX(eUDP, to_ip);
+	}
+
+/*!
+* @brief number of slots received or to send
+*/
+	int numberOfSlots ( void ) { return _protocol.P::numberOfSlots(); }
+
+/*!
+* @brief set number of slots to send
+*/
+	void setNumberOfSlots ( int n ) { _protocol.P::setNumberOfSlots(n); }
+
+/*!
+* @brief pointer to slot 1 in the packet buffer (dmxData() differs between protocols)
+* @return NULL if the protocol has no packet buffer
+*/
+	uint8_t* slots ( void ) {
+		if ( _buffer == NULL ) {
+			return NULL;
+		}
+		return &_buffer[1];
+	}
+
+/*!
+* @brief get level data from slot/address/channel
+* @param slot 1 to 512
+*/
+	uint8_t getSlot ( int slot ) {
+		if ( _buffer == NULL ) {
+			return 0;
+		}
+		return _buffer[slot];
+	}
+
+/*!
+* @brief get level from merged data, enableHTP() must have been called on the protocol
+* @param slot 1 to 512
+*/
+	uint8_t getHTPSlot ( int slot ) {
+		return _protocol.P::getHTPSlot(slot);
+	}
+
+/*!
+* @brief set level data (0-255) for slot/address/channel
+* @param slot 1 to 512
+*/
+	void setSlot ( int slot, uint8_t value ) {
+		if ( _buffer != NULL ) {
+			_buffer[slot] = value;
+		}
+	}
+
+/*!
+* @brief copy levels of consecutive slots
+* @param count number of slots (limited to end of universe)
+*/
+	void getSlots ( int start, int count, uint8_t* dst ) {
+		count = LXDMXEthernet::slotRangeCount(start, count);
+		if ( count && ( _buffer != NULL )) {
+			memcpy(dst, &_buffer[start], count);
+		}
+	}
+
+/*!
+* @brief set levels of consecutive slots
+* @param count number of slots (limited to end of universe)
+*/
+	void setSlots ( int start, int count, const uint8_t* src ) {
+		count = LXDMXEthernet::slotRangeCount(start, count);
+		if ( count && ( _buffer != NULL )) {
+			memcpy(&_buffer[start], src, count);
+		}
+	}
+
+/*!
+* @brief view of received universe or slot window, merged if HTP is enabled
+*/
+	LXDMXSpan universeSpan ( void ) {
+		return _protocol.P::universeSpan();
+	}
+
+  private:
+	P& _protocol;
+/// protocol's packet buffer offset so that _buffer[n] is slot n, NULL if none
+	uint8_t* _buffer;
+};
+
+#endif // ifndef LXDMXNODE_H
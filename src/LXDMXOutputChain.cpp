@@ -0,0 +1,114 @@
+/* LXDMXOutputChain.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXOutputChain.h"
+#include <string.h>
+
+LXDMXOutputChain::LXDMXOutputChain ( void ) {
+	_invert = NULL;
+	_offsets = NULL;
+	_limits = NULL;
+	setMaster(255);
+}
+
+LXDMXOutputChain::~LXDMXOutputChain ( void ) {
+}
+
+void LXDMXOutputChain::setMaster ( uint8_t level ) {
+	_master = level;
+	_scale = level + ( level >> 7 );			// 0-127 unchanged, 128-255 -> 129-256
+	update_stages();
+}
+
+uint8_t LXDMXOutputChain::master ( void ) {
+	return _master;
+}
+
+void LXDMXOutputChain::setInvertMask ( const uint8_t* mask ) {
+	_invert = mask;
+	update_stages();
+}
+
+void LXDMXOutputChain::setOffsets ( const int8_t* offsets ) {
+	_offsets = offsets;
+	update_stages();
+}
+
+void LXDMXOutputChain::setLimits ( const uint8_t* limits ) {
+	_limits = limits;
+	update_stages();
+}
+
+uint8_t LXDMXOutputChain::stages ( void ) {
+	return _stages;
+}
+
+void LXDMXOutputChain::update_stages ( void ) {
+	_stages = 0;
+	if ( _invert != NULL ) {
+		_stages |= LXDMX_STAGE_INVERT;
+	}
+	if ( _master != 255 ) {
+		_stages |= LXDMX_STAGE_MASTER;
+	}
+	if ( _offsets != NULL ) {
+		_stages |= LXDMX_STAGE_OFFSET;
+	}
+	if ( _limits != NULL ) {
+		_stages |= LXDMX_STAGE_LIMIT;
+	}
+}
+
+void LXDMXOutputChain::process ( const uint8_t* src, uint8_t* dst, uint16_t count ) {
+	process(src, dst, count, 1);
+}
+
+void LXDMXOutputChain::processSpan ( LXDMXSpan span, uint8_t* dst ) {
+	process(span.slots, dst, span.count, span.start);
+}
+
+void LXDMXOutputChain::process ( const uint8_t* src, uint8_t* dst, uint16_t count, uint16_t first ) {
+	uint16_t i;
+	uint16_t scale = _scale;
+
+	if ( _stages == 0 ) {
+		if ( dst != src ) {
+			memcpy(dst, src, count);
+		}
+		return;
+	}
+
+	if ( _stages == LXDMX_STAGE_MASTER ) {
+		for (i=0; i<count; i++) {
+			dst[i] = ( src[i] * scale ) >> 8;
+		}
+		return;
+	}
+
+	// per slot arrays are indexed from slot 1
+	uint16_t s = first - 1;
+	uint8_t invert = _stages & LXDMX_STAGE_INVERT;
+	const int8_t* offsets = _offsets;
+	const uint8_t* limits = _limits;
+	for (i=0; i<count; i++, s++) {
+		int16_t v = src[i];
+		if ( invert && ( _invert[s >> 3] & ( 1 << ( s & 7 )))) {
+			v = 255 - v;
+		}
+		v = ( v * scale ) >> 8;
+		if ( offsets != NULL ) {
+			v += offsets[s];
+			if ( v < 0 ) {
+				v = 0;
+			} else if ( v > 255 ) {
+				v = 255;
+			}
+		}
+		if (( limits != NULL ) && ( v > limits[s] )) {
+			v = limits[s];
+		}
+		dst[i] = v;
+	}
+}
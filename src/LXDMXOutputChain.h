@@ -0,0 +1,103 @@
+/* LXDMXOutputChain.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXOUTPUTCHAIN_H
+#define LXDMXOUTPUTCHAIN_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include "LXDMXEthernet.h"
+
+// stages, set in stages() when configured
+#define LXDMX_STAGE_INVERT	0x01
+#define LXDMX_STAGE_MASTER	0x02
+#define LXDMX_STAGE_OFFSET	0x04
+#define LXDMX_STAGE_LIMIT	0x08
+
+/*!
+@class LXDMXOutputChain
+@abstract
+   LXDMXOutputChain adjusts received levels on their way to an output.
+
+   Stages are applied to each slot in this order:
+      invert   slots with their bit set in the invert mask become 255 - level
+      master   level x master / 255, a local grand master
+      offset   a signed offset per slot, the result is kept within 0-255
+      limit    a maximum level per slot, for example a power budget
+
+   Only configured stages are applied, all in a single pass over the slots.
+   With only the master configured a simpler loop is used, and with none
+   process() is a copy.
+
+   The invert mask, offsets and limits are arrays supplied by the sketch
+   (indexed from slot 1) and must remain valid while in use.  They are read,
+   not copied, so they may be changed at any time.
+*/
+class LXDMXOutputChain {
+
+  public:
+	LXDMXOutputChain ( void );
+   ~LXDMXOutputChain ( void );
+
+/*!
+* @brief local master
+* @param level 0-255, 255 (default) is unchanged
+*/
+	void     setMaster     ( uint8_t level );
+	uint8_t  master        ( void );
+
+/*!
+* @brief slots to invert
+* @param mask bit (slot-1)&7 of mask[(slot-1)>>3] set to invert slot, NULL to remove
+*/
+	void     setInvertMask ( const uint8_t* mask );
+/*!
+* @brief offset added to each slot
+* @param offsets -128 to 127 for each slot, NULL to remove
+*/
+	void     setOffsets    ( const int8_t* offsets );
+/*!
+* @brief maximum level of each slot
+* @param limits 0-255 for each slot, NULL to remove
+*/
+	void     setLimits     ( const uint8_t* limits );
+
+/*!
+* @brief configured stages, LXDMX_STAGE_INVERT | LXDMX_STAGE_MASTER...
+*/
+	uint8_t  stages        ( void );
+
+/*!
+* @brief apply the chain to count slots
+* @param src levels, src[0] is slot first
+* @param dst output levels, may be the same as src
+* @param count number of slots
+* @param first slot number of src[0], 1 unless src is a slot window
+*/
+	void     process       ( const uint8_t* src, uint8_t* dst, uint16_t count, uint16_t first );
+	void     process       ( const uint8_t* src, uint8_t* dst, uint16_t count );
+/*!
+* @brief apply the chain to a received universe
+* @param span from universeSpan()
+* @param dst span.count output levels
+*/
+	void     processSpan   ( LXDMXSpan span, uint8_t* dst );
+
+  private:
+	uint8_t        _master;
+/// master scaled so that 255 is 256, level x _scale >> 8
+	uint16_t       _scale;
+	const uint8_t* _invert;
+	const int8_t*  _offsets;
+	const uint8_t* _limits;
+	uint8_t        _stages;
+
+/*!
+* @brief recompute _stages
+*/
+	void           update_stages ( void );
+};
+
+#endif // ifndef LXDMXOUTPUTCHAIN_H
@@ -0,0 +1,69 @@
+/* LXDMXRateMeter.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXDMXRateMeter has no dependencies on Arduino so it can also be
+   compiled on a host.
+*/
+
+#ifndef LXDMXRATEMETER_H
+#define LXDMXRATEMETER_H
+
+#include <inttypes.h>
+
+// milliseconds over which the rate is measured
+#define LXDMX_RATE_PERIOD 1000
+
+/*!
+@class LXDMXRateMeter
+@abstract
+   LXDMXRateMeter turns a running frame count into frames per second.
+
+   sample() is called with the count and millis() whenever the rate is read.
+   Once a period has passed, the rate is recomputed from the frames counted
+   during it.  Between updates the last rate is returned.
+*/
+class LXDMXRateMeter {
+
+  public:
+	LXDMXRateMeter ( void ) {
+		_start_frames = 0;
+		_start_ms = 0;
+		_rate = 0;
+	}
+
+/*!
+* @brief update and return the rate
+* @param frames running count of frames
+* @param now millis()
+* @return frames per second during the last complete period
+*/
+	uint16_t sample ( uint32_t frames, uint32_t now ) {
+		uint32_t elapsed = now - _start_ms;
+		if ( elapsed >= LXDMX_RATE_PERIOD ) {
+			uint32_t counted = frames - _start_frames;
+			if ( elapsed < 65536 ) {
+				_rate = ( counted * 1000 + elapsed / 2 ) / elapsed;
+			} else {
+				_rate = counted / ( elapsed / 1000 );	// not sampled for a while, avoid overflow
+			}
+			_start_frames = frames;
+			_start_ms = now;
+		}
+		return _rate;
+	}
+
+/*!
+* @brief last computed rate, frames per second
+*/
+	uint16_t rate ( void ) {
+		return _rate;
+	}
+
+  private:
+	uint32_t _start_frames;
+	uint32_t _start_ms;
+	uint16_t _rate;
+};
+
+#endif // ifndef LXDMXRATEMETER_H
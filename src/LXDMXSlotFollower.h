@@ -0,0 +1,106 @@
+/* LXDMXSlotFollower.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXDMXSlotFollower has no dependencies on Arduino so it can also be
+   compiled on a host.
+*/
+
+#ifndef LXDMXSLOTFOLLOWER_H
+#define LXDMXSLOTFOLLOWER_H
+
+#include <inttypes.h>
+
+// fewest slots sent, keeps break to break above the E1.11 minimum
+#define LXDMX_FOLLOW_MIN_SLOTS 24
+#define LXDMX_FOLLOW_MAX_SLOTS 512
+// consecutive shorter frames before the output slot count is reduced
+#define LXDMX_FOLLOW_SHRINK_FRAMES 8
+
+/*!
+@class LXDMXSlotFollower
+@abstract
+   LXDMXSlotFollower sets the number of slots an output driver sends from the
+   number of slots received, so that a short universe refreshes faster than a
+   full 512 slot frame.
+
+   The count grows as soon as a longer frame is received so no data is dropped.
+   It shrinks only after a number of consecutive shorter frames, to the longest
+   of those frames, so that a source alternating between lengths does not
+   change the frame rate on every packet.
+*/
+class LXDMXSlotFollower {
+
+  public:
+	LXDMXSlotFollower ( void ) {
+		_minimum = LXDMX_FOLLOW_MIN_SLOTS;
+		_shrink_frames = LXDMX_FOLLOW_SHRINK_FRAMES;
+		_slots = LXDMX_FOLLOW_MAX_SLOTS;
+		_shorter = 0;
+		_candidate = 0;
+	}
+
+/*!
+* @brief fewest slots returned by update()
+* @param slots 1-512, driver's DMX_MIN_SLOTS
+*/
+	void setMinimum ( uint16_t slots ) {
+		if (( slots > 0 ) && ( slots <= LXDMX_FOLLOW_MAX_SLOTS )) {
+			_minimum = slots;
+		}
+	}
+
+/*!
+* @brief number of consecutive shorter frames before the count is reduced
+* @param frames 1 follows every frame
+*/
+	void setShrinkFrames ( uint8_t frames ) {
+		_shrink_frames = ( frames > 0 ) ? frames : 1;
+	}
+
+/*!
+* @brief record the slots in a received frame
+* @param received numberOfSlots() of the received packet
+* @return number of slots to send
+*/
+	uint16_t update ( uint16_t received ) {
+		if ( received < _minimum ) {
+			received = _minimum;
+		} else if ( received > LXDMX_FOLLOW_MAX_SLOTS ) {
+			received = LXDMX_FOLLOW_MAX_SLOTS;
+		}
+		if ( received >= _slots ) {
+			_slots = received;
+			_shorter = 0;
+			_candidate = 0;
+		} else {
+			if ( received > _candidate ) {
+				_candidate = received;
+			}
+			_shorter++;
+			if ( _shorter >= _shrink_frames ) {
+				_slots = _candidate;
+				_shorter = 0;
+				_candidate = 0;
+			}
+		}
+		return _slots;
+	}
+
+/*!
+* @brief current number of slots to send
+*/
+	uint16_t slots ( void ) {
+		return _slots;
+	}
+
+  private:
+	uint16_t _minimum;
+	uint16_t _slots;
+/// longest of the shorter frames since the count last changed
+	uint16_t _candidate;
+	uint8_t  _shrink_frames;
+	uint8_t  _shorter;
+};
+
+#endif // ifndef LXDMXSLOTFOLLOWER_H
@@ -0,0 +1,211 @@
+/* LXDMXTripleBuffer.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXDMXTripleBuffer has no dependencies on Arduino other than disabling
+   interrupts for the index swap so it can also be compiled on a host
+   with a simulated ISR.
+*/
+
+#ifndef LXDMXTRIPLEBUFFER_H
+#define LXDMXTRIPLEBUFFER_H
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+// start code plus 512 slots
+#define LXDMX_FRAME_SIZE 513
+
+// not enough memory on these for three frames, buffering is single frame only
+#if defined(__AVR_ATmega168__) || defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega32U4__)
+#define LXDMX_TRIPLE_BUFFER_FRAMES 1
+#else
+#define LXDMX_TRIPLE_BUFFER_FRAMES 3
+#endif
+
+// the index swap is a few instructions with interrupts disabled
+#if defined(__AVR__)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#define LXDMX_CRITICAL_BEGIN	uint8_t _lx_sreg = SREG; cli();
+#define LXDMX_CRITICAL_END		SREG = _lx_sreg;
+#elif defined(__arm__)
+#include <Arduino.h>
+#define LXDMX_CRITICAL_BEGIN	uint32_t _lx_primask = __get_PRIMASK(); __disable_irq();
+#define LXDMX_CRITICAL_END		__set_PRIMASK(_lx_primask);
+#else
+#define LXDMX_CRITICAL_BEGIN
+#define LXDMX_CRITICAL_END
+#endif
+
+/*!
+@class LXDMXTripleBuffer
+@abstract
+   LXDMXTripleBuffer hands complete DMX frames between a producer and a consumer
+   running in different contexts (main loop and ISR) without either waiting for the other.
+
+   The producer fills writeFrame() and calls publish().  The consumer calls acquire()
+   at the start of each frame and then reads only readFrame().  The third frame holds
+   the most recently published data.  Publishing and acquiring swap indexes,
+   so the consumer always starts on a complete, consistent frame.
+
+   For DMX output the main loop is the producer and the TX ISR is the consumer.
+   For DMX input the RX ISR is the producer and the main loop is the consumer.
+
+   Buffering is disabled by default.  Then all three indexes refer to the same frame,
+   publish() and acquire() do nothing and behavior is the same as a single buffer.
+   Only that frame is part of the object.  The other two frames (1026 bytes) are
+   allocated when buffering is enabled and freed when it is disabled.
+*/
+class LXDMXTripleBuffer {
+
+  public:
+	LXDMXTripleBuffer ( void ) {
+		memset(_frame, 0, LXDMX_FRAME_SIZE);
+		_extra = NULL;
+		for ( uint8_t i=0; i<3; i++ ) {
+			_frames[i] = _frame;
+		}
+		_write = 0;
+		_read = 0;
+		_ready = 0;
+		_fresh = 0;
+	}
+
+	~LXDMXTripleBuffer ( void ) {
+		if ( _extra != NULL ) {
+			free(_extra);
+		}
+	}
+
+/*!
+* @brief enable or disable triple buffering
+* @discussion Should only be called when the ISR is not running.
+*             Has no effect if only one frame fits in RAM (LXDMX_TRIPLE_BUFFER_FRAMES)
+*             or the two extra frames cannot be allocated.
+* @return 1 if buffering is enabled
+*/
+	uint8_t setEnabled ( uint8_t enable ) {
+		_write = 0;
+		_ready = 0;
+		_read = 0;
+		_fresh = 0;
+		if ( enable && ( LXDMX_TRIPLE_BUFFER_FRAMES == 3 )) {
+			if ( _extra == NULL ) {
+				_extra = (uint8_t*) malloc(2 * LXDMX_FRAME_SIZE);
+			}
+			if ( _extra != NULL ) {
+				_frames[1] = _extra;
+				_frames[2] = &_extra[LXDMX_FRAME_SIZE];
+				memcpy(_frames[1], _frame, LXDMX_FRAME_SIZE);
+				memcpy(_frames[2], _frame, LXDMX_FRAME_SIZE);
+				_ready = 1;
+				_read = 2;
+				return 1;
+			}
+		}
+		_frames[1] = _frame;
+		_frames[2] = _frame;
+		if ( _extra != NULL ) {
+			free(_extra);
+			_extra = NULL;
+		}
+		return 0;
+	}
+
+/*!
+* @brief true if producer and consumer have separate frames
+*/
+	uint8_t enabled ( void ) {
+		return _write != _read;
+	}
+
+/*!
+* @brief frame owned by the producer
+*/
+	uint8_t* writeFrame ( void ) {
+		return _frames[_write];
+	}
+
+/*!
+* @brief frame owned by the consumer
+*/
+	uint8_t* readFrame ( void ) {
+		return _frames[_read];
+	}
+
+/*!
+* @brief producer hands its complete frame to the consumer
+* @discussion The new write frame is the one the consumer last released.
+*             With copy_forward it is refreshed with the published data so
+*             that changing individual slots (setSlot) continues from the published frame.
+* @param copy_forward copy published data into new write frame
+*/
+	void publish ( uint8_t copy_forward ) {
+		if ( _write == _read ) {
+			return;
+		}
+		uint8_t published = _write;
+		LXDMX_CRITICAL_BEGIN
+		_write = _ready;
+		_ready = published;
+		_fresh = 1;
+		LXDMX_CRITICAL_END
+		if ( copy_forward ) {
+			memcpy(_frames[_write], _frames[published], LXDMX_FRAME_SIZE);
+		}
+	}
+
+/*!
+* @brief consumer takes the most recently published frame
+* @return 1 if readFrame() is now a newly published frame
+*/
+	uint8_t acquire ( void ) {
+		uint8_t result = 0;
+		LXDMX_CRITICAL_BEGIN
+		if ( _fresh ) {
+			uint8_t released = _read;
+			_read = _ready;
+			_ready = released;
+			_fresh = 0;
+			result = 1;
+		}
+		LXDMX_CRITICAL_END
+		return result;
+	}
+
+/*!
+* @brief true if a frame has been published and not acquired
+*/
+	uint8_t fresh ( void ) {
+		return _fresh;
+	}
+
+/*!
+* @brief zero all frames
+*/
+	void clear ( void ) {
+		memset(_frame, 0, LXDMX_FRAME_SIZE);
+		if ( _extra != NULL ) {
+			memset(_extra, 0, 2 * LXDMX_FRAME_SIZE);
+		}
+	}
+
+  private:
+/// frame used when not buffering, always frame 0
+	uint8_t  _frame[LXDMX_FRAME_SIZE];
+/// frames 1 and 2, allocated when buffering is enabled
+	uint8_t* _extra;
+	uint8_t* _frames[3];
+/// frame owned by producer
+	volatile uint8_t  _write;
+/// frame owned by consumer
+	volatile uint8_t  _read;
+/// most recently published frame
+	volatile uint8_t  _ready;
+/// _ready has been published since consumer's last acquire
+	volatile uint8_t  _fresh;
+};
+
+#endif // ifndef LXDMXTRIPLEBUFFER_H
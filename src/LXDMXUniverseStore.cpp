@@ -0,0 +1,187 @@
+/* LXDMXUniverseStore.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXDMXUniverseStore.h"
+#include <stdlib.h>
+#include <string.h>
+
+LXDMXUniverseStore::LXDMXUniverseStore ( uint8_t count ) {
+	_universes = NULL;
+	if ( count <= LXDMX_STORE_MAX_COUNT ) {
+		_universes = (LXDMXUniverseData*) malloc(count * sizeof(LXDMXUniverseData));
+	}
+	_owns_universes = 1;
+	if ( _universes != NULL ) {
+		_count = count;
+	} else {
+		_count = 0;
+	}
+	_policy = LXDMX_MERGE_PRIORITY;
+	_artnet_priority = LXDMX_DEFAULT_PRIORITY;
+	clear();
+}
+
+LXDMXUniverseStore::LXDMXUniverseStore ( uint8_t count, LXDMXArena* arena ) {
+	_universes = NULL;
+	if ( count <= LXDMX_STORE_MAX_COUNT ) {
+		_universes = (LXDMXUniverseData*) arena->allocate(count * sizeof(LXDMXUniverseData));
+	}
+	_owns_universes = 0;
+	if ( _universes != NULL ) {
+		_count = count;
+	} else {
+		_count = 0;
+	}
+	_policy = LXDMX_MERGE_PRIORITY;
+	_artnet_priority = LXDMX_DEFAULT_PRIORITY;
+	clear();
+}
+
+LXDMXUniverseStore::~LXDMXUniverseStore ( void ) {
+	if ( _owns_universes && ( _universes != NULL )) {
+		free(_universes);
+	}
+}
+
+uint8_t LXDMXUniverseStore::count ( void ) {
+	return _count;
+}
+
+void LXDMXUniverseStore::setPolicy ( uint8_t policy ) {
+	_policy = policy;
+	for (uint8_t i=0; i<_count; i++) {
+		merge(i);
+	}
+}
+
+uint8_t LXDMXUniverseStore::policy ( void ) {
+	return _policy;
+}
+
+void LXDMXUniverseStore::setArtNetPriority ( uint8_t priority ) {
+	_artnet_priority = priority;
+	for (uint8_t i=0; i<_count; i++) {
+		merge(i);
+	}
+}
+
+void LXDMXUniverseStore::update ( uint8_t index, uint8_t source, uint8_t* data, uint16_t slots, uint8_t priority ) {
+	if (( index >= _count ) || ( source >= LXDMX_STORE_SOURCES )) {
+		return;
+	}
+	if ( slots > LXDMX_STORE_SLOTS ) {
+		slots = LXDMX_STORE_SLOTS;
+	}
+	LXDMXUniverseData* u = &_universes[index];
+	memcpy(u->source[source], data, slots);
+	if ( slots < u->source_slots[source] ) {		// zero slots no longer sent
+		memset(&u->source[source][slots], 0, u->source_slots[source] - slots);
+	}
+	u->source_slots[source] = slots;
+	u->source_priority[source] = priority;
+	u->source_time[source] = millis();
+	u->last_source = source;
+	merge(index);
+}
+
+uint8_t* LXDMXUniverseStore::data ( uint8_t index ) {
+	if ( index < _count ) {
+		return _universes[index].merged;
+	}
+	return NULL;
+}
+
+uint16_t LXDMXUniverseStore::numberOfSlots ( uint8_t index ) {
+	if ( index < _count ) {
+		return _universes[index].slots;
+	}
+	return 0;
+}
+
+uint8_t LXDMXUniverseStore::getSlot ( uint8_t index, int slot ) {
+	if (( index < _count ) && ( slot > 0 ) && ( slot <= LXDMX_STORE_SLOTS )) {
+		return _universes[index].merged[slot-1];
+	}
+	return 0;
+}
+
+uint8_t LXDMXUniverseStore::sourceActive ( uint8_t index, uint8_t source ) {
+	if (( index >= _count ) || ( source >= LXDMX_STORE_SOURCES )) {
+		return 0;
+	}
+	LXDMXUniverseData* u = &_universes[index];
+	if ( u->source_slots[source] ) {
+		return ( millis() - u->source_time[source] ) <= LXDMX_STORE_TIMEOUT;
+	}
+	return 0;
+}
+
+void LXDMXUniverseStore::checkTimeouts ( void ) {
+	for (uint8_t i=0; i<_count; i++) {
+		LXDMXUniverseData* u = &_universes[i];
+		uint8_t changed = 0;
+		for (uint8_t s=0; s<LXDMX_STORE_SOURCES; s++) {
+			if ( u->source_slots[s] && ( ! sourceActive(i, s) )) {
+				memset(u->source[s], 0, u->source_slots[s]);
+				u->source_slots[s] = 0;
+				changed = 1;
+			}
+		}
+		if ( changed ) {
+			merge(i);
+		}
+	}
+}
+
+void LXDMXUniverseStore::clear ( void ) {
+	if ( _universes != NULL ) {
+		memset(_universes, 0, _count * sizeof(LXDMXUniverseData));
+	}
+}
+
+void LXDMXUniverseStore::merge ( uint8_t index ) {
+	LXDMXUniverseData* u = &_universes[index];
+	uint8_t use[LXDMX_STORE_SOURCES];
+	uint8_t s;
+	for (s=0; s<LXDMX_STORE_SOURCES; s++) {
+		use[s] = sourceActive(index, s);
+	}
+
+	if ( use[LXDMX_SOURCE_ARTNET] && use[LXDMX_SOURCE_SACN] ) {
+		if ( _policy == LXDMX_MERGE_LTP ) {
+			use[1 - u->last_source] = 0;
+		} else if ( _policy == LXDMX_MERGE_PRIORITY ) {
+			uint8_t sacn_priority = u->source_priority[LXDMX_SOURCE_SACN];
+			if ( sacn_priority > _artnet_priority ) {
+				use[LXDMX_SOURCE_ARTNET] = 0;
+			} else if ( _artnet_priority > sacn_priority ) {
+				use[LXDMX_SOURCE_SACN] = 0;
+			}							// equal priority is HTP
+		}
+	}
+
+	uint16_t slots = 0;
+	for (s=0; s<LXDMX_STORE_SOURCES; s++) {
+		if ( use[s] && ( u->source_slots[s] > slots )) {
+			slots = u->source_slots[s];
+		}
+	}
+
+	if ( use[LXDMX_SOURCE_ARTNET] && use[LXDMX_SOURCE_SACN] ) {
+		uint8_t* a = u->source[LXDMX_SOURCE_ARTNET];
+		uint8_t* b = u->source[LXDMX_SOURCE_SACN];
+		for (uint16_t i=0; i<slots; i++) {		// source buffers are zero beyond their slots
+			u->merged[i] = ( a[i] > b[i] ) ? a[i] : b[i];
+		}
+	} else if ( use[LXDMX_SOURCE_ARTNET] ) {
+		memcpy(u->merged, u->source[LXDMX_SOURCE_ARTNET], slots);
+	} else if ( use[LXDMX_SOURCE_SACN] ) {
+		memcpy(u->merged, u->source[LXDMX_SOURCE_SACN], slots);
+	}
+	if ( slots < u->slots ) {
+		memset(&u->merged[slots], 0, u->slots - slots);
+	}
+	u->slots = slots;
+}
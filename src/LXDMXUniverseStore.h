@@ -0,0 +1,168 @@
+/* LXDMXUniverseStore.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXDMXUNIVERSESTORE_H
+#define LXDMXUNIVERSESTORE_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include "LXDMXArena.h"
+
+#define LXDMX_STORE_SLOTS 512
+
+// a protocol source is dropped from the merge if not heard from for this many milliseconds
+#define LXDMX_STORE_TIMEOUT 3000
+
+// how Art-Net and sACN data for the same universe are combined
+#define LXDMX_MERGE_PRIORITY	0
+#define LXDMX_MERGE_HTP			1
+#define LXDMX_MERGE_LTP			2
+
+// sACN default priority, also the default fixed priority of Art-Net
+#define LXDMX_DEFAULT_PRIORITY 100
+
+#define LXDMX_SOURCE_ARTNET	0
+#define LXDMX_SOURCE_SACN	1
+#define LXDMX_STORE_SOURCES	2
+
+/*!
+* @brief data for one universe of an LXDMXUniverseStore
+*/
+typedef struct {
+/// combined output, read with LXDMXUniverseStore data()
+	uint8_t       merged[LXDMX_STORE_SLOTS];
+/// last data from each protocol
+	uint8_t       source[LXDMX_STORE_SOURCES][LXDMX_STORE_SLOTS];
+/// slots in last data from each protocol, zero if not active
+	uint16_t      source_slots[LXDMX_STORE_SOURCES];
+/// priority of each protocol's data
+	uint8_t       source_priority[LXDMX_STORE_SOURCES];
+/// millis() when each protocol's data was received
+	unsigned long source_time[LXDMX_STORE_SOURCES];
+/// source that most recently updated, for LTP
+	uint8_t       last_source;
+/// slots in merged
+	uint16_t      slots;
+} LXDMXUniverseData;
+
+// most universes whose size fits in a size_t (42 where size_t is 16 bits)
+#define LXDMX_STORE_MAX_COUNT (((size_t)-1) / sizeof(LXDMXUniverseData))
+// LXDMXArena bytes used by a store of n universes
+#define LXDMX_STORE_ARENA_BYTES(n) LXDMX_ARENA_ALIGNED((n) * sizeof(LXDMXUniverseData))
+
+/*!
+@class LXDMXUniverseStore
+@abstract
+   LXDMXUniverseStore holds one merged buffer per universe with data from
+   both Art-Net and sACN.
+
+   Attach a receiver with setUniverseStore(store, index).  When it accepts DMX
+   (merged if its enableHTP() has been called) the data is copied to the store
+   for that protocol and the universe's merged buffer is recomputed.
+   An LXArtNet and an LXSACN receiver attached to the same index are combined,
+   so outputs read data(index) regardless of which protocol it came from.
+   A receiver with a slot window (setSlotWindow) stores its window as slots 1 to len.
+
+   Merge policies:
+      LXDMX_MERGE_PRIORITY  the source with the highest priority is output.  sACN uses
+                            the packet's priority, Art-Net a fixed priority (setArtNetPriority).
+                            Equal priorities are merged HTP.
+      LXDMX_MERGE_HTP       highest level of each slot.
+      LXDMX_MERGE_LTP       the source most recently received.
+
+   A source not received for LXDMX_STORE_TIMEOUT is removed from the merge.
+*/
+class LXDMXUniverseStore {
+
+  public:
+/*!
+* @brief constructor allocates storage for count universes
+* @discussion Each universe uses sizeof(LXDMXUniverseData), a little over 1.5K.
+*/
+	LXDMXUniverseStore ( uint8_t count );
+/*!
+* @brief constructor takes storage for count universes from an arena
+* @param arena LXDMXArena with LXDMX_STORE_ARENA_BYTES(count) remaining
+*/
+	LXDMXUniverseStore ( uint8_t count, LXDMXArena* arena );
+   ~LXDMXUniverseStore ( void );
+
+/*!
+* @brief number of universes, zero if allocation failed
+*/
+	uint8_t  count           ( void );
+
+/*!
+* @brief set merge policy
+* @param policy LXDMX_MERGE_PRIORITY, LXDMX_MERGE_HTP or LXDMX_MERGE_LTP
+*/
+	void     setPolicy       ( uint8_t policy );
+	uint8_t  policy          ( void );
+
+/*!
+* @brief set priority of Art-Net data for LXDMX_MERGE_PRIORITY
+* @param priority 0-200 as sACN, default 100
+*/
+	void     setArtNetPriority ( uint8_t priority );
+
+/*!
+* @brief store data received from a protocol and recompute merge
+* @param index universe index 0 to count-1
+* @param source LXDMX_SOURCE_ARTNET or LXDMX_SOURCE_SACN
+* @param data pointer to slot 1
+* @param slots number of slots
+* @param priority sACN priority, ignored for Art-Net
+*/
+	void     update          ( uint8_t index, uint8_t source, uint8_t* data, uint16_t slots, uint8_t priority );
+
+/*!
+* @brief merged data for universe
+* @return pointer to slot 1, NULL if index is out of range
+*/
+	uint8_t* data            ( uint8_t index );
+/*!
+* @brief number of slots in merged data
+*/
+	uint16_t numberOfSlots   ( uint8_t index );
+/*!
+* @brief merged level of a slot
+* @param slot 1 to 512
+* @return level, 0 if index or slot is out of range
+*/
+	uint8_t  getSlot         ( uint8_t index, int slot );
+
+/*!
+* @brief true if source has sent data for universe within LXDMX_STORE_TIMEOUT
+* @return 0 if index or source is out of range
+*/
+	uint8_t  sourceActive    ( uint8_t index, uint8_t source );
+
+/*!
+* @brief remove sources that have timed out and recompute merges
+* @discussion call from loop to have outputs go to zero (or the remaining source)
+*             when a source stops sending
+*/
+	void     checkTimeouts   ( void );
+
+/*!
+* @brief clear all data
+*/
+	void     clear           ( void );
+
+  private:
+	LXDMXUniverseData* _universes;
+/// _universes was allocated with malloc
+	uint8_t            _owns_universes;
+	uint8_t            _count;
+	uint8_t            _policy;
+	uint8_t            _artnet_priority;
+
+/*!
+* @brief recompute merged buffer for universe
+*/
+	void     merge           ( uint8_t index );
+};
+
+#endif // ifndef LXDMXUNIVERSESTORE_H
@@ -0,0 +1,141 @@
+/* LXPixelEncoder.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXPixelEncoder.h"
+#include <stdlib.h>
+#include <string.h>
+
+// symbols for the four bits of a half byte, most significant first
+static const uint16_t SPI4_NIBBLE[16] = {
+	0x8888, 0x888e, 0x88e8, 0x88ee, 0x8e88, 0x8e8e, 0x8ee8, 0x8eee,
+	0xe888, 0xe88e, 0xe8e8, 0xe8ee, 0xee88, 0xee8e, 0xeee8, 0xeeee
+};
+
+// 12 bits, symbols for the four bits of a half byte
+static const uint16_t SPI3_NIBBLE[16] = {
+	0x924, 0x926, 0x934, 0x936, 0x9a4, 0x9a6, 0x9b4, 0x9b6,
+	0xd24, 0xd26, 0xd34, 0xd36, 0xda4, 0xda6, 0xdb4, 0xdb6
+};
+
+LXPixelEncoder::LXPixelEncoder ( uint8_t mode, uint16_t bytes ) {
+	_mode = mode;
+	uint32_t size = encodedSize(mode, bytes);
+	_buffers[0] = NULL;
+	_buffers[1] = NULL;
+	if ( size <= LXPIXEL_ENCODE_MAX_LENGTH ) {
+		_buffers[0] = (uint8_t*) malloc(size);
+		_buffers[1] = (uint8_t*) malloc(size);
+	}
+	_owns_buffers = 1;
+	initialize(bytes);
+}
+
+LXPixelEncoder::LXPixelEncoder ( uint8_t mode, uint16_t bytes, LXDMXArena* arena ) {
+	_mode = mode;
+	uint32_t size = encodedSize(mode, bytes);
+	_buffers[0] = NULL;
+	_buffers[1] = NULL;
+	if ( size <= LXPIXEL_ENCODE_MAX_LENGTH ) {
+		_buffers[0] = arena->allocate(size);
+		_buffers[1] = arena->allocate(size);
+	}
+	_owns_buffers = 0;
+	initialize(bytes);
+}
+
+LXPixelEncoder::~LXPixelEncoder ( void ) {
+	if ( _owns_buffers ) {
+		free(_buffers[0]);		// free(NULL) does nothing
+		free(_buffers[1]);
+	}
+}
+
+void LXPixelEncoder::initialize ( uint16_t bytes ) {
+	_front = 0;
+	_lengths[0] = 0;
+	_lengths[1] = 0;
+	if (( _buffers[0] == NULL ) || ( _buffers[1] == NULL )) {
+		_capacity = 0;
+	} else {
+		_capacity = bytes;
+		uint16_t size = (uint16_t) encodedSize(_mode, bytes);
+		memset(_buffers[0], 0, size);		// latch bytes stay zero
+		memset(_buffers[1], 0, size);
+	}
+}
+
+uint16_t LXPixelEncoder::capacity ( void ) {
+	return _capacity;
+}
+
+uint8_t LXPixelEncoder::mode ( void ) {
+	return _mode;
+}
+
+uint16_t LXPixelEncoder::encode ( const uint8_t* pixels, uint16_t count ) {
+	uint8_t back = 1 - _front;
+	uint8_t* dst = _buffers[back];
+	if (( _capacity == 0 ) || ( dst == NULL )) {
+		return 0;						// no buffers, nothing is written
+	}
+	if ( count > _capacity ) {
+		count = _capacity;
+	}
+	encodeBytes(_mode, pixels, dst, count);
+	uint16_t length = (uint16_t) encodedSize(_mode, count);
+	if ( _mode != LXPIXEL_ENCODE_BYTES ) {
+		memset(&dst[length - LXPIXEL_ENCODE_LATCH_BYTES], 0, LXPIXEL_ENCODE_LATCH_BYTES);
+	}
+	_lengths[back] = length;
+	return length;
+}
+
+void LXPixelEncoder::swap ( void ) {
+	_front = 1 - _front;
+}
+
+uint8_t* LXPixelEncoder::frontBuffer ( void ) {
+	return _buffers[_front];
+}
+
+uint16_t LXPixelEncoder::length ( void ) {
+	return _lengths[_front];
+}
+
+uint32_t LXPixelEncoder::encodedSize ( uint8_t mode, uint16_t bytes ) {
+	switch ( mode ) {
+		case LXPIXEL_ENCODE_SPI3:
+			return 3 * (uint32_t)bytes + LXPIXEL_ENCODE_LATCH_BYTES;
+		case LXPIXEL_ENCODE_SPI4:
+			return 4 * (uint32_t)bytes + LXPIXEL_ENCODE_LATCH_BYTES;
+	}
+	return bytes;
+}
+
+void LXPixelEncoder::encodeBytes ( uint8_t mode, const uint8_t* src, uint8_t* dst, uint16_t count ) {
+	uint16_t i;
+	if ( mode == LXPIXEL_ENCODE_SPI4 ) {
+		for (i=0; i<count; i++) {
+			uint16_t h = SPI4_NIBBLE[src[i] >> 4];
+			uint16_t l = SPI4_NIBBLE[src[i] & 0x0f];
+			dst[0] = h >> 8;
+			dst[1] = h;
+			dst[2] = l >> 8;
+			dst[3] = l;
+			dst += 4;
+		}
+	} else if ( mode == LXPIXEL_ENCODE_SPI3 ) {
+		for (i=0; i<count; i++) {
+			uint16_t h = SPI3_NIBBLE[src[i] >> 4];
+			uint16_t l = SPI3_NIBBLE[src[i] & 0x0f];
+			dst[0] = h >> 4;
+			dst[1] = ( h << 4 ) | ( l >> 8 );
+			dst[2] = l;
+			dst += 3;
+		}
+	} else {
+		memcpy(dst, src, count);
+	}
+}
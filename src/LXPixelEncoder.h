@@ -0,0 +1,120 @@
+/* LXPixelEncoder.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXPixelEncoder has no dependencies on Arduino so it can also be
+   compiled and timed on a host.
+*/
+
+#ifndef LXPIXELENCODER_H
+#define LXPIXELENCODER_H
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "LXDMXArena.h"
+
+// pixel bytes copied unchanged, for drivers that generate the timing themselves
+#define LXPIXEL_ENCODE_BYTES	0
+// 3 SPI bits per data bit (0 = 100, 1 = 110), SPI clock 2.4MHz
+#define LXPIXEL_ENCODE_SPI3		1
+// 4 SPI bits per data bit (0 = 1000, 1 = 1110), SPI clock 3.2MHz
+#define LXPIXEL_ENCODE_SPI4		2
+
+// zero bytes after the data hold the line low > 50us to latch (at 3.2MHz)
+#define LXPIXEL_ENCODE_LATCH_BYTES 24
+// largest encoded length, length() is 16 bits (16377 pixel bytes in SPI4 mode, 21837 in SPI3)
+#define LXPIXEL_ENCODE_MAX_LENGTH 0xFFFF
+
+/*!
+@class LXPixelEncoder
+@abstract
+   LXPixelEncoder converts a pixel buffer (for example one written by LXPixelMapper
+   in the strip's GRB or GRBW order) into the stream clocked out to WS2812/SK6812
+   pixels by SPI, DMA or another peripheral.
+
+   In the SPI modes each data bit becomes a 3 or 4 bit symbol whose high time gives
+   the 0 or 1 pulse.  Each half byte is looked up in a 16 entry table so a pixel
+   byte costs two table reads.
+
+   There are two output buffers.  encode() writes the back buffer while the front
+   buffer may still be transmitting.  swap() makes the new data the front buffer
+   once the previous transmission is complete.
+
+   LXPixelEncoder encoder(LXPIXEL_ENCODE_SPI4, NUM_LEDS*3);
+   encoder.encode(pixels, NUM_LEDS*3);
+   // when previous transfer is done:
+   encoder.swap();
+   SPI.transfer(encoder.frontBuffer(), encoder.length());
+*/
+class LXPixelEncoder {
+
+  public:
+/*!
+* @brief constructor allocates two output buffers
+* @param mode LXPIXEL_ENCODE_BYTES, LXPIXEL_ENCODE_SPI3 or LXPIXEL_ENCODE_SPI4
+* @param bytes maximum pixel bytes (pixels x 3 or 4)
+* @discussion capacity() is zero if the encoded size is over LXPIXEL_ENCODE_MAX_LENGTH
+*/
+	LXPixelEncoder ( uint8_t mode, uint16_t bytes );
+/*!
+* @brief constructor takes output buffers from an arena
+* @param arena LXDMXArena with 2 x LXDMX_ARENA_ALIGNED(encodedSize(mode, bytes)) remaining
+*/
+	LXPixelEncoder ( uint8_t mode, uint16_t bytes, LXDMXArena* arena );
+   ~LXPixelEncoder ( void );
+
+/*!
+* @brief maximum pixel bytes, zero if allocation failed
+*/
+	uint16_t capacity    ( void );
+	uint8_t  mode        ( void );
+
+/*!
+* @brief encode pixel bytes into the back buffer
+* @param pixels bytes in the order sent to the strip
+* @param count number of bytes, limited to capacity()
+* @return encoded length, 0 if capacity() is 0
+*/
+	uint16_t encode      ( const uint8_t* pixels, uint16_t count );
+
+/*!
+* @brief exchange buffers, the last encoded data becomes the front buffer
+*/
+	void     swap        ( void );
+
+/*!
+* @brief buffer to transmit
+*/
+	uint8_t* frontBuffer ( void );
+/*!
+* @brief bytes to transmit from frontBuffer(), including latch bytes in the SPI modes
+*/
+	uint16_t length      ( void );
+
+/*!
+* @brief buffer size needed to encode bytes
+* @discussion 32 bits so that sizes over LXPIXEL_ENCODE_MAX_LENGTH can be rejected
+*/
+	static uint32_t encodedSize ( uint8_t mode, uint16_t bytes );
+/*!
+* @brief encode count pixel bytes into dst (encodedSize(mode, count) bytes)
+*/
+	static void     encodeBytes ( uint8_t mode, const uint8_t* src, uint8_t* dst, uint16_t count );
+
+  private:
+	uint8_t*  _buffers[2];
+	uint16_t  _lengths[2];
+/// index of the front buffer, 1 - _front is written by encode
+	uint8_t   _front;
+	uint8_t   _mode;
+	uint16_t  _capacity;
+/// buffers were allocated with malloc
+	uint8_t   _owns_buffers;
+
+/*!
+* @brief initialize after buffers are allocated
+*/
+	void      initialize ( uint16_t bytes );
+};
+
+#endif // ifndef LXPIXELENCODER_H
@@ -0,0 +1,135 @@
+/* LXPixelMapper.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXPixelMapper.h"
+#include <string.h>
+
+uint8_t LXPixelMapper::orderSize ( uint8_t order ) {
+	return LXPixelOrder::size(order);
+}
+
+uint8_t LXPixelMapper::orderComponent ( uint8_t order, uint8_t i ) {
+	return LXPixelOrder::component(order, i);
+}
+
+LXPixelMapper::LXPixelMapper ( uint16_t pixels, uint8_t dmx_order, uint8_t pixel_order ) {
+	_target = NULL;
+	_pixels = pixels;
+	_dmx_size = orderSize(dmx_order);
+	_pixel_size = orderSize(pixel_order);
+	_same_order = ( dmx_order == pixel_order );
+
+	for (uint8_t j=0; j<4; j++) {
+		_map[j] = LXPIXEL_NONE;
+		uint8_t c = orderComponent(pixel_order, j);
+		for (uint8_t i=0; i<_dmx_size; i++) {
+			if (( c != LXPIXEL_NONE ) && ( orderComponent(dmx_order, i) == c )) {
+				_map[j] = i;
+			}
+		}
+	}
+	setStart(0, 1);
+}
+
+LXPixelMapper::~LXPixelMapper ( void ) {
+}
+
+void LXPixelMapper::setStart ( uint16_t universe, uint16_t address ) {
+	_start_universe = universe;
+	build_runs(address);
+}
+
+void LXPixelMapper::setTarget ( uint8_t* pixels ) {
+	_target = pixels;
+}
+
+uint16_t LXPixelMapper::numberOfPixels ( void ) {
+	return _pixels;
+}
+
+uint16_t LXPixelMapper::startUniverse ( void ) {
+	return _start_universe;
+}
+
+uint8_t LXPixelMapper::universeCount ( void ) {
+	return _run_count;
+}
+
+uint16_t LXPixelMapper::mapUniverse ( uint16_t universe, const uint8_t* data, uint16_t slots ) {
+	return mapUniverse(universe, data, slots, 1);
+}
+
+uint16_t LXPixelMapper::mapSpan ( uint16_t universe, LXDMXSpan span ) {
+	return mapUniverse(universe, span.slots, span.count, span.start);
+}
+
+uint16_t LXPixelMapper::mapUniverse ( uint16_t universe, const uint8_t* data, uint16_t slots, uint16_t first ) {
+	uint16_t u = universe - _start_universe;
+	if (( universe < _start_universe ) || ( u >= _run_count ) || ( _target == NULL )) {
+		return 0;
+	}
+	LXPixelRun* run = &_runs[u];
+	if ( run->slot < first ) {						// window starts after first pixel
+		return 0;
+	}
+	uint16_t offset = run->slot - first;
+	if ( offset >= slots ) {
+		return 0;
+	}
+	uint16_t count = ( slots - offset ) / _dmx_size;	// complete pixels received
+	if ( count > run->count ) {
+		count = run->count;
+	}
+
+	const uint8_t* src = &data[offset];
+	uint8_t* dst = &_target[run->pixel * _pixel_size];
+	if ( _same_order ) {
+		memcpy(dst, src, count * _pixel_size);
+	} else if ( _pixel_size == 3 ) {
+		uint8_t m0 = _map[0];
+		uint8_t m1 = _map[1];
+		uint8_t m2 = _map[2];
+		for (uint16_t p=0; p<count; p++) {
+			dst[0] = ( m0 == LXPIXEL_NONE ) ? 0 : src[m0];
+			dst[1] = ( m1 == LXPIXEL_NONE ) ? 0 : src[m1];
+			dst[2] = ( m2 == LXPIXEL_NONE ) ? 0 : src[m2];
+			src += _dmx_size;
+			dst += 3;
+		}
+	} else {
+		for (uint16_t p=0; p<count; p++) {
+			for (uint8_t j=0; j<4; j++) {
+				dst[j] = ( _map[j] == LXPIXEL_NONE ) ? 0 : src[_map[j]];
+			}
+			src += _dmx_size;
+			dst += 4;
+		}
+	}
+	return count;
+}
+
+void LXPixelMapper::build_runs ( uint16_t address ) {
+	if (( address < 1 ) || ( address > DMX_UNIVERSE_SIZE )) {
+		address = 1;
+	}
+	uint16_t per_universe = DMX_UNIVERSE_SIZE / _dmx_size;		// 170 RGB, 128 RGBW
+	uint16_t pixel = 0;
+	_run_count = 0;
+	while (( pixel < _pixels ) && ( _run_count < LXPIXEL_MAX_UNIVERSES )) {
+		uint16_t count = ( DMX_UNIVERSE_SIZE + 1 - address ) / _dmx_size;
+		if ( count > per_universe ) {
+			count = per_universe;
+		}
+		if ( count > _pixels - pixel ) {
+			count = _pixels - pixel;
+		}
+		_runs[_run_count].slot = address;
+		_runs[_run_count].pixel = pixel;
+		_runs[_run_count].count = count;
+		_run_count++;
+		pixel += count;
+		address = 1;			// following universes start at slot 1
+	}
+}
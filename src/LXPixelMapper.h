@@ -0,0 +1,125 @@
+/* LXPixelMapper.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXPIXELMAPPER_H
+#define LXPIXELMAPPER_H
+
+#include <Arduino.h>
+#include <inttypes.h>
+#include "LXDMXEthernet.h"
+#include "LXPixelOrder.h"
+
+// maximum universes spanned by one mapper
+#define LXPIXEL_MAX_UNIVERSES 16
+
+/*!
+* @brief part of one universe copied to the pixel buffer
+*/
+typedef struct {
+/// slot number (1-512) of the first pixel's first channel
+	uint16_t slot;
+/// index of first pixel
+	uint16_t pixel;
+/// number of pixels
+	uint16_t count;
+} LXPixelRun;
+
+/*!
+@class LXPixelMapper
+@abstract
+   LXPixelMapper copies DMX from one or more consecutive universes into a pixel
+   buffer such as Adafruit_NeoPixel getPixels().
+
+   Pixels start at an address in the start universe and continue from slot 1
+   of the following universes.  A pixel is never split between universes, so a
+   universe holds 170 RGB or 128 RGBW pixels.
+
+   The slot and pixel ranges for each universe are computed when the mapping is set.
+   mapUniverse() then copies a run of pixels with memcpy when the DMX and pixel
+   orders are the same, or reorders each pixel using a precomputed table.
+
+   LXPixelMapper mapper(NUM_LEDS, LXPIXEL_ORDER_RGB, LXPIXEL_ORDER_GRB);
+   mapper.setTarget(ring.getPixels());
+   ...
+   mapper.mapUniverse(universe, data, slots);   // from an LXDMXReceivedCallback
+*/
+class LXPixelMapper {
+
+  public:
+/*!
+* @brief constructor
+* @param pixels number of pixels
+* @param dmx_order order of channels in DMX, LXPIXEL_ORDER_RGB etc.
+* @param pixel_order order of bytes in the pixel buffer
+*/
+	LXPixelMapper ( uint16_t pixels, uint8_t dmx_order, uint8_t pixel_order );
+   ~LXPixelMapper ( void );
+
+/*!
+* @brief set the location of the first pixel
+* @param universe universe number of the first pixel as received (Art-Net Port-Address or sACN universe)
+* @param address slot 1-512 of the first pixel's first channel
+*/
+	void     setStart       ( uint16_t universe, uint16_t address );
+
+/*!
+* @brief set the buffer written by mapUniverse()
+* @param pixels buffer of at least numberOfPixels() x orderSize(pixel_order) bytes
+*/
+	void     setTarget      ( uint8_t* pixels );
+
+	uint16_t numberOfPixels ( void );
+	uint16_t startUniverse  ( void );
+/*!
+* @brief number of universes spanned by the pixels
+* @discussion Pixels past LXPIXEL_MAX_UNIVERSES are not mapped.
+*/
+	uint8_t  universeCount  ( void );
+
+/*!
+* @brief copy the pixels in a universe to the target buffer
+* @param universe universe number as received
+* @param data pointer to slot first
+* @param slots number of slots in data
+* @param first slot number of data[0], 1 unless the receiver has a slot window
+* @return number of pixels copied, 0 if none are in this universe
+*/
+	uint16_t mapUniverse    ( uint16_t universe, const uint8_t* data, uint16_t slots, uint16_t first );
+	uint16_t mapUniverse    ( uint16_t universe, const uint8_t* data, uint16_t slots );
+/*!
+* @brief copy the pixels in a universe to the target buffer
+* @param span from universeSpan()
+*/
+	uint16_t mapSpan        ( uint16_t universe, LXDMXSpan span );
+
+/*!
+* @brief number of bytes per pixel for an order, 3 or 4, same as LXPixelOrder::size
+*/
+	static uint8_t orderSize      ( uint8_t order );
+/*!
+* @brief component at position i (0-3) of an order, same as LXPixelOrder::component
+*/
+	static uint8_t orderComponent ( uint8_t order, uint8_t i );
+
+  private:
+	uint8_t*   _target;
+	uint16_t   _pixels;
+	uint16_t   _start_universe;
+	uint8_t    _dmx_size;
+	uint8_t    _pixel_size;
+/// orders are the same, copy runs with memcpy
+	uint8_t    _same_order;
+/// for each byte of a pixel in the target, index of the DMX channel or LXPIXEL_NONE
+	uint8_t    _map[4];
+	uint8_t    _run_count;
+	LXPixelRun _runs[LXPIXEL_MAX_UNIVERSES];
+
+/*!
+* @brief compute the run for each universe
+*/
+	void       build_runs     ( uint16_t address );
+};
+
+#endif // ifndef LXPIXELMAPPER_H
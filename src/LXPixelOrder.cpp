@@ -0,0 +1,33 @@
+/* LXPixelOrder.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXPixelOrder.h"
+
+// size followed by the component in each position
+static const uint8_t PIXEL_ORDERS[LXPIXEL_ORDER_COUNT][5] = {
+	{ 3, LXPIXEL_RED,   LXPIXEL_GREEN, LXPIXEL_BLUE,  LXPIXEL_NONE },	// RGB
+	{ 3, LXPIXEL_RED,   LXPIXEL_BLUE,  LXPIXEL_GREEN, LXPIXEL_NONE },	// RBG
+	{ 3, LXPIXEL_GREEN, LXPIXEL_RED,   LXPIXEL_BLUE,  LXPIXEL_NONE },	// GRB
+	{ 3, LXPIXEL_GREEN, LXPIXEL_BLUE,  LXPIXEL_RED,   LXPIXEL_NONE },	// GBR
+	{ 3, LXPIXEL_BLUE,  LXPIXEL_RED,   LXPIXEL_GREEN, LXPIXEL_NONE },	// BRG
+	{ 3, LXPIXEL_BLUE,  LXPIXEL_GREEN, LXPIXEL_RED,   LXPIXEL_NONE },	// BGR
+	{ 4, LXPIXEL_RED,   LXPIXEL_GREEN, LXPIXEL_BLUE,  LXPIXEL_WHITE },	// RGBW
+	{ 4, LXPIXEL_GREEN, LXPIXEL_RED,   LXPIXEL_BLUE,  LXPIXEL_WHITE },	// GRBW
+	{ 4, LXPIXEL_WHITE, LXPIXEL_RED,   LXPIXEL_GREEN, LXPIXEL_BLUE }	// WRGB
+};
+
+uint8_t LXPixelOrder::size ( uint8_t order ) {
+	if ( order < LXPIXEL_ORDER_COUNT ) {
+		return PIXEL_ORDERS[order][0];
+	}
+	return 3;
+}
+
+uint8_t LXPixelOrder::component ( uint8_t order, uint8_t i ) {
+	if (( order < LXPIXEL_ORDER_COUNT ) && ( i < 4 )) {
+		return PIXEL_ORDERS[order][i+1];
+	}
+	return LXPIXEL_NONE;
+}
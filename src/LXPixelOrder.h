@@ -0,0 +1,52 @@
+/* LXPixelOrder.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+
+   LXPixelOrder has no dependencies on Arduino so that LXPixelRGBW can also be
+   compiled and timed on a host.
+*/
+
+#ifndef LXPIXELORDER_H
+#define LXPIXELORDER_H
+
+#include <inttypes.h>
+
+// color orders of DMX slots and of the pixel buffer
+#define LXPIXEL_ORDER_RGB	0
+#define LXPIXEL_ORDER_RBG	1
+#define LXPIXEL_ORDER_GRB	2
+#define LXPIXEL_ORDER_GBR	3
+#define LXPIXEL_ORDER_BRG	4
+#define LXPIXEL_ORDER_BGR	5
+#define LXPIXEL_ORDER_RGBW	6
+#define LXPIXEL_ORDER_GRBW	7
+#define LXPIXEL_ORDER_WRGB	8
+#define LXPIXEL_ORDER_COUNT	9
+
+// components of a pixel, as stored in an order
+#define LXPIXEL_RED		0
+#define LXPIXEL_GREEN	1
+#define LXPIXEL_BLUE	2
+#define LXPIXEL_WHITE	3
+#define LXPIXEL_NONE	0xff
+
+/*!
+@class LXPixelOrder
+@abstract
+   LXPixelOrder describes the LXPIXEL_ORDER_xxx color orders shared by
+   LXPixelMapper and LXPixelRGBW.
+*/
+class LXPixelOrder {
+
+  public:
+/*!
+* @brief number of bytes per pixel for an order, 3 or 4
+*/
+	static uint8_t size      ( uint8_t order );
+/*!
+* @brief component at position i (0-3) of an order, LXPIXEL_RED...LXPIXEL_WHITE or LXPIXEL_NONE
+*/
+	static uint8_t component ( uint8_t order, uint8_t i );
+};
+
+#endif // ifndef LXPIXELORDER_H
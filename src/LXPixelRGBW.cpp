@@ -0,0 +1,106 @@
+/* LXPixelRGBW.cpp
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#include "LXPixelRGBW.h"
+
+LXPixelRGBW::LXPixelRGBW ( uint8_t order ) {
+	if ( LXPixelOrder::size(order) != 4 ) {
+		order = LXPIXEL_ORDER_RGBW;
+	}
+	for (uint8_t i=0; i<4; i++) {
+		_position[LXPixelOrder::component(order, i)] = i;
+	}
+	_mode = LXPIXEL_WHITE_MIN;
+	setWhitePoint(LXPIXEL_Q8_ONE, LXPIXEL_Q8_ONE, LXPIXEL_Q8_ONE);
+	setBalance(LXPIXEL_Q8_ONE, LXPIXEL_Q8_ONE, LXPIXEL_Q8_ONE, LXPIXEL_Q8_ONE);
+}
+
+LXPixelRGBW::~LXPixelRGBW ( void ) {
+}
+
+void LXPixelRGBW::setMode ( uint8_t mode ) {
+	_mode = mode;
+}
+
+uint8_t LXPixelRGBW::mode ( void ) {
+	return _mode;
+}
+
+void LXPixelRGBW::setWhitePoint ( uint16_t red, uint16_t green, uint16_t blue ) {
+	uint16_t wp[3] = { red, green, blue };
+	for (uint8_t i=0; i<3; i++) {
+		if ( wp[i] < 1 ) {
+			wp[i] = 1;
+		} else if ( wp[i] > LXPIXEL_Q8_ONE ) {
+			wp[i] = LXPIXEL_Q8_ONE;
+		}
+		_white_point[i] = wp[i];
+		_white_scale[i] = 65536UL / wp[i];
+	}
+}
+
+void LXPixelRGBW::setBalance ( uint16_t red, uint16_t green, uint16_t blue, uint16_t white ) {
+	uint16_t gain[4] = { red, green, blue, white };
+	for (uint8_t i=0; i<4; i++) {
+		// gain above 1.0 would overflow the 8 bit output
+		_balance[i] = ( gain[i] > LXPIXEL_Q8_ONE ) ? LXPIXEL_Q8_ONE : gain[i];
+	}
+}
+
+void LXPixelRGBW::convert ( const uint8_t* rgb, uint8_t* out, uint16_t pixels ) {
+	uint8_t pr = _position[LXPIXEL_RED];
+	uint8_t pg = _position[LXPIXEL_GREEN];
+	uint8_t pb = _position[LXPIXEL_BLUE];
+	uint8_t pw = _position[LXPIXEL_WHITE];
+	uint16_t br = _balance[LXPIXEL_RED];
+	uint16_t bg = _balance[LXPIXEL_GREEN];
+	uint16_t bb = _balance[LXPIXEL_BLUE];
+	uint16_t bw = _balance[LXPIXEL_WHITE];
+	uint16_t p;
+
+	if ( _mode == LXPIXEL_WHITE_CALIBRATED ) {
+		uint32_t sr = _white_scale[0];
+		uint32_t sg = _white_scale[1];
+		uint32_t sb = _white_scale[2];
+		uint16_t wr = _white_point[0];
+		uint16_t wg = _white_point[1];
+		uint16_t wb = _white_point[2];
+		for (p=0; p<pixels; p++) {
+			uint16_t r = rgb[0];
+			uint16_t g = rgb[1];
+			uint16_t b = rgb[2];
+			// white level that would produce each channel, the lowest fits all three
+			uint32_t w = ( r * sr ) >> 8;
+			uint32_t t = ( g * sg ) >> 8;
+			if ( t < w ) w = t;
+			t = ( b * sb ) >> 8;
+			if ( t < w ) w = t;
+			if ( w > 255 ) w = 255;
+			r -= ( w * wr ) >> 8;
+			g -= ( w * wg ) >> 8;
+			b -= ( w * wb ) >> 8;
+			out[pr] = ( r * br ) >> 8;
+			out[pg] = ( g * bg ) >> 8;
+			out[pb] = ( b * bb ) >> 8;
+			out[pw] = ( w * bw ) >> 8;
+			rgb += 3;
+			out += 4;
+		}
+	} else {
+		for (p=0; p<pixels; p++) {
+			uint16_t r = rgb[0];
+			uint16_t g = rgb[1];
+			uint16_t b = rgb[2];
+			uint16_t w = ( r < g ) ? r : g;
+			w = ( b < w ) ? b : w;
+			out[pr] = (( r - w ) * br ) >> 8;
+			out[pg] = (( g - w ) * bg ) >> 8;
+			out[pb] = (( b - w ) * bb ) >> 8;
+			out[pw] = ( w * bw ) >> 8;
+			rgb += 3;
+			out += 4;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+/* LXPixelRGBW.h
+   Copyright 2026 by Claude Heintz Design
+   see LXDMXEthernet.h for license
+*/
+
+#ifndef LXPIXELRGBW_H
+#define LXPIXELRGBW_H
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "LXPixelOrder.h"
+
+// white is the lowest of red, green and blue
+#define LXPIXEL_WHITE_MIN			0
+// white is scaled by the color of the white LED, see setWhitePoint
+#define LXPIXEL_WHITE_CALIBRATED	1
+
+// balance and white point value for 1.0
+#define LXPIXEL_Q8_ONE 256
+
+/*!
+@class LXPixelRGBW
+@abstract
+   LXPixelRGBW converts RGB pixels to RGBW for strips with a white LED.
+
+   The white level is the part common to red, green and blue, which is then removed
+   from them.  In LXPIXEL_WHITE_MIN mode that is the minimum of the three.  In
+   LXPIXEL_WHITE_CALIBRATED mode the white LED's own mix of red, green and blue
+   (setWhitePoint) is removed so the color is unchanged for a warm or cool white.
+
+   Each output channel is then scaled by its balance (Q8, 256 = 1.0).
+   Gains and reciprocals are computed when they are set so that convert() is one
+   pass of multiplies and shifts with no division.
+
+   Use after LXPixelMapper writes a buffer in RGB order:
+   LXPixelMapper mapper(NUM_LEDS, LXPIXEL_ORDER_RGB, LXPIXEL_ORDER_RGB);
+   LXPixelRGBW rgbw(LXPIXEL_ORDER_GRBW);
+   rgbw.convert(rgb_buffer, strip.getPixels(), NUM_LEDS);
+*/
+class LXPixelRGBW {
+
+  public:
+/*!
+* @brief constructor
+* @param order output order, LXPIXEL_ORDER_RGBW, LXPIXEL_ORDER_GRBW or LXPIXEL_ORDER_WRGB
+*/
+	LXPixelRGBW ( uint8_t order );
+   ~LXPixelRGBW ( void );
+
+/*!
+* @brief LXPIXEL_WHITE_MIN or LXPIXEL_WHITE_CALIBRATED
+*/
+	void     setMode       ( uint8_t mode );
+	uint8_t  mode          ( void );
+
+/*!
+* @brief red, green and blue produced by the white LED at full, relative to the RGB LEDs
+* @discussion Q8, 256 = same as the RGB LED at full.  Values are 1 to 256.
+*             Default 256, 256, 256 is the same as LXPIXEL_WHITE_MIN.
+*/
+	void     setWhitePoint ( uint16_t red, uint16_t green, uint16_t blue );
+
+/*!
+* @brief output gain for each channel, Q8, 256 = 1.0 (default and maximum)
+*/
+	void     setBalance    ( uint16_t red, uint16_t green, uint16_t blue, uint16_t white );
+
+/*!
+* @brief convert pixels from 3 byte RGB to 4 byte output order
+* @param rgb pixels x 3 bytes
+* @param out pixels x 4 bytes, must not overlap rgb
+*/
+	void     convert       ( const uint8_t* rgb, uint8_t* out, uint16_t pixels );
+
+  private:
+	uint8_t  _mode;
+/// position of red, green, blue and white in each output pixel
+	uint8_t  _position[4];
+/// balance, Q8
+	uint16_t _balance[4];
+/// white point, Q8
+	uint16_t _white_point[3];
+/// 65536 / white point, scales a level to the white that produces it
+	uint32_t _white_scale[3];
+};
+
+#endif // ifndef LXPIXELRGBW_H
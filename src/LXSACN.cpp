@@ -13,12 +13,17 @@
 
 LXSACN::LXSACN ( void )
 {
-	initialize(0);
+	initialize((uint8_t*) malloc(SACN_BUFFER_MAX), 1);
 }
 
 LXSACN::LXSACN ( uint8_t* buffer )
 {
-	initialize(buffer);
+	initialize(buffer, 0);
+}
+
+LXSACN::LXSACN ( LXDMXArena* arena )
+{
+	initialize(arena->allocate(SACN_BUFFER_MAX), 0);
 }
 
 LXSACN::~LXSACN ( void )
@@ -26,30 +31,29 @@ LXSACN::~LXSACN ( void )
 	if ( _owns_buffer ) {		// if we created this buffer, then free the memory
 		free(_packet_buffer);
 	}
-	if ( _using_htp ) {
+	if ( _owns_htp_buffers ) {
 		free(_dmx_buffer_a);
 		free(_dmx_buffer_b);
 		free(_dmx_buffer_c);
 	}
 }
 
-void  LXSACN::initialize  ( uint8_t* b ) {
-	if ( b == 0 ) {
-		// create buffer
-		_packet_buffer = (uint8_t*) malloc(SACN_BUFFER_MAX);
-		_owns_buffer = 1;
-	} else {
-		// external buffer.  Size MUST be >=SACN_BUFFER_MAX
-		_packet_buffer = b;
-		_owns_buffer = 0;
-	}
+void  LXSACN::initialize  ( uint8_t* b, uint8_t owns ) {
+	// allocated by constructor or external buffer.  Size MUST be >=SACN_BUFFER_MAX
+	_packet_buffer = b;
+	_owns_buffer = owns;
 	
     //zero buffer and CID
-    memset(_packet_buffer, 0, SACN_BUFFER_MAX);
+    if ( _packet_buffer != NULL ) {		// NULL if malloc or arena failed
+    	memset(_packet_buffer, 0, SACN_BUFFER_MAX);
+    }
     memset(_dmx_sender_id, 0, SACN_CID_LENGTH);
     memset(_dmx_sender_id_b, 0, SACN_CID_LENGTH);
     
     _using_htp    = 0;
+    _owns_htp_buffers = 0;
+    _htp_size     = DMX_UNIVERSE_SIZE;
+    _window_first = 0;
     _dmx_buffer_a = 0;
     _dmx_buffer_b = 0;
     _dmx_buffer_c = 0;
@@ -59,6 +63,13 @@ void  LXSACN::initialize  ( uint8_t* b ) {
     _dmx_slots_b = 0;
     _universe = 1;                    // NOTE: unlike Art-Net, sACN universes begin at 1
     _sequence = 1;
+    _dmx_received_time = 0;
+    _latency_monitor = 0;
+    _dmx_received_callback = 0;
+    _universe_store = 0;
+    _store_index = 0;
+    _changed_first = 0;
+    _changed_last = 0;
 }
 
 uint8_t  LXSACN::universe ( void ) {
@@ -74,20 +85,77 @@ void LXSACN::enableHTP() {
 	// not enough memory on these to allocate these buffers
 #else
 	if ( ! _using_htp ) {
-		_dmx_buffer_a = (uint8_t*) malloc(DMX_UNIVERSE_SIZE);
-		_dmx_buffer_b = (uint8_t*) malloc(DMX_UNIVERSE_SIZE);
-		_dmx_buffer_c = (uint8_t*) malloc(DMX_UNIVERSE_SIZE);
-		for(int i=0; i<DMX_UNIVERSE_SIZE; i++) {
+		// buffers hold the slot window, all 512 slots unless setSlotWindow was called
+		_dmx_buffer_a = (uint8_t*) malloc(_htp_size);
+		_dmx_buffer_b = (uint8_t*) malloc(_htp_size);
+		_dmx_buffer_c = (uint8_t*) malloc(_htp_size);
+		if (( _dmx_buffer_a == NULL ) || ( _dmx_buffer_b == NULL ) || ( _dmx_buffer_c == NULL )) {
+			free(_dmx_buffer_a);	// free(NULL) does nothing
+			free(_dmx_buffer_b);
+			free(_dmx_buffer_c);
+			return;
+		}
+		_owns_htp_buffers = 1;
+		for(int i=0; i<_htp_size; i++) {
 		   _dmx_buffer_a[i] = 0;
 		   _dmx_buffer_b[i] = 0;
 		   _dmx_buffer_c[i] = 0;
 		}
-		
 		_using_htp = 1;
 	}
 #endif
 }
 
+uint8_t LXSACN::enableHTP( LXDMXArena* arena ) {
+	if ( ! _using_htp ) {
+		if ( arena->remaining() < (size_t)( 3 * LXDMX_ARENA_ALIGNED(_htp_size) )) {
+			return 0;
+		}
+		_dmx_buffer_a = arena->allocate(_htp_size);
+		_dmx_buffer_b = arena->allocate(_htp_size);
+		_dmx_buffer_c = arena->allocate(_htp_size);
+		memset(_dmx_buffer_a, 0, _htp_size);
+		memset(_dmx_buffer_b, 0, _htp_size);
+		memset(_dmx_buffer_c, 0, _htp_size);
+		_using_htp = 1;
+	}
+	return 1;
+}
+
+uint8_t LXSACN::enableLowMemoryHTP( uint16_t slots ) {
+	if ( ! _using_htp ) {
+		if (( slots == 0 ) || ( slots > _htp_size )) {
+			slots = _htp_size;
+		}
+		_dmx_buffer_a = (uint8_t*) malloc(slots);
+		_dmx_buffer_b = (uint8_t*) malloc(slots);
+		if (( _dmx_buffer_a == NULL ) || ( _dmx_buffer_b == NULL )) {
+			free(_dmx_buffer_a);
+			free(_dmx_buffer_b);
+			return 0;
+		}
+		_dmx_buffer_c = NULL;					// merged data is written back to the packet buffer
+		memset(_dmx_buffer_a, 0, slots);
+		memset(_dmx_buffer_b, 0, slots);
+		_owns_htp_buffers = 1;
+		_htp_size = slots;
+		_using_htp = 1;
+	}
+	return 1;
+}
+
+uint8_t LXSACN::setSlotWindow( uint16_t start, uint16_t len ) {
+	if ( _using_htp || ( start < 1 ) || ( start > DMX_UNIVERSE_SIZE ) || ( len == 0 )) {
+		return 0;
+	}
+	if ( len > DMX_UNIVERSE_SIZE + 1 - start ) {
+		len = DMX_UNIVERSE_SIZE + 1 - start;
+	}
+	_window_first = start - 1;
+	_htp_size = len;
+	return 1;
+}
+
 int  LXSACN::numberOfSlots ( void ) {
 	return _dmx_slots;
 }
@@ -97,26 +165,76 @@ void LXSACN::setNumberOfSlots ( int n ) {
 }
 
 uint8_t LXSACN::getSlot ( int slot ) {
+	if ( _packet_buffer == NULL ) {
+		return 0;
+	}
 	return _packet_buffer[SACN_ADDRESS_OFFSET+slot];
 }
 
 uint8_t LXSACN::getHTPSlot ( int slot ) {
-	return _dmx_buffer_c[slot-1];
+	uint16_t i = slot - 1 - _window_first;		// index in slot window
+	if ( i < _htp_size ) {
+		if ( _dmx_buffer_c != NULL ) {
+			return _dmx_buffer_c[i];
+		}
+		uint8_t a = _dmx_buffer_a[i];				// low memory HTP, merge on demand
+		uint8_t b = _dmx_buffer_b[i];
+		return ( a > b ) ? a : b;
+	}
+	return 0;
 }
 
 void LXSACN::setSlot ( int slot, uint8_t value ) {
-	_packet_buffer[SACN_ADDRESS_OFFSET+slot] = value;
+	if ( _packet_buffer != NULL ) {
+		_packet_buffer[SACN_ADDRESS_OFFSET+slot] = value;
+	}
 }
 
 uint8_t LXSACN::startCode ( void ) {
+	if ( _packet_buffer == NULL ) {
+		return 0;
+	}
 	return _packet_buffer[SACN_ADDRESS_OFFSET];
 }
 
 void LXSACN::setStartCode ( uint8_t value ) {
-	_packet_buffer[SACN_ADDRESS_OFFSET] = value;
+	if ( _packet_buffer != NULL ) {
+		_packet_buffer[SACN_ADDRESS_OFFSET] = value;
+	}
+}
+
+void LXSACN::getSlots ( int start, int count, uint8_t* dst ) {
+	count = slotRangeCount(start, count);
+	if ( count && ( _packet_buffer != NULL )) {
+		memcpy(dst, &_packet_buffer[SACN_ADDRESS_OFFSET+start], count);
+	}
+}
+
+void LXSACN::setSlots ( int start, int count, const uint8_t* src ) {
+	count = slotRangeCount(start, count);
+	if ( count && ( _packet_buffer != NULL )) {
+		memcpy(&_packet_buffer[SACN_ADDRESS_OFFSET+start], src, count);
+	}
+}
+
+LXDMXSpan LXSACN::universeSpan ( void ) {
+	LXDMXSpan span;
+	if ( _packet_buffer == NULL ) {
+		span.slots = NULL;
+		span.count = 0;
+		span.start = 0;
+		return span;
+	}
+	span.slots = window_data();
+	span.count = window_slots();
+	span.start = _window_first + 1;
+	return span;
 }
 
 uint8_t* LXSACN::dmxData( void ) {
+	if ( _packet_buffer == NULL ) {
+		return NULL;
+	}
 	return &_packet_buffer[SACN_ADDRESS_OFFSET];
 }
 
@@ -130,7 +248,7 @@ uint8_t LXSACN::readDMXPacket ( UDP* eUDP ) {
 }
 
 uint8_t LXSACN::readDMXPacketContents ( UDP* eUDP, int packetSize ) {
-   if ( packetSize > 0 ) {
+   if (( packetSize > 0 ) && ( _packet_buffer != NULL )) {
 		if ( parse_root_layer(packetSize) ) {
 			if ( startCode() == 0 ) {
 				return RESULT_DMX_RECEIVED;
@@ -142,14 +260,30 @@ uint8_t LXSACN::readDMXPacketContents ( UDP* eUDP, int packetSize ) {
 
 uint16_t LXSACN::readSACNPacket ( UDP* eUDP ) {
    uint16_t packetSize = eUDP->parsePacket();
-   if ( packetSize ) {
-      packetSize = eUDP->read(_packet_buffer, SACN_BUFFER_MAX);
+   if ( packetSize && ( _packet_buffer != NULL )) {
+      uint16_t size = packetSize;
+      packetSize = eUDP->read(_packet_buffer, SACN_HEADER_PEEK);
+      if (( packetSize == SACN_HEADER_PEEK ) && other_universe(size) ) {
+         // start code and data are left unread, parsePacket() discards them
+         _counters.countPacket(SACN_COUNT_DATA);
+         _counters.countRejected(LXDMX_REJECT_WRONG_UNIVERSE);
+         return 0;
+      }
+      if ( packetSize == SACN_HEADER_PEEK ) {
+         int rest = eUDP->read(&_packet_buffer[SACN_HEADER_PEEK], SACN_BUFFER_MAX - SACN_HEADER_PEEK);
+         if ( rest > 0 ) {
+            packetSize += rest;
+         }
+      }
       return parse_root_layer(packetSize);
    }
    return 0;
 }
 
 void LXSACN::sendDMX( UDP* eUDP, IPAddress to_ip ) {
+   if ( _packet_buffer == NULL ) {
+      return;
+   }
    for (int n=0; n<126; n++) {
     	_packet_buffer[n] = 0;		// zero outside layers & start code
     }
@@ -224,11 +358,34 @@ uint16_t LXSACN::parse_root_layer( int size ) {
       uint16_t tsize = size - 16;
       if ( checkFlagsAndLength(&_packet_buffer[16], tsize) ) { // root pdu length
         if ( _packet_buffer[21] == 0x04 ) {							// vector RLP is 1.31 data
+          _counters.countPacket(SACN_COUNT_DATA);
           return parse_framing_layer( tsize );
         }
+        if ( _packet_buffer[21] == 0x08 ) {
+          _counters.countPacket(SACN_COUNT_EXTENDED);
+        } else {
+          _counters.countPacket(SACN_COUNT_OTHER);
+        }
+        return 0;
       }
+      _counters.countPacket(SACN_COUNT_OTHER);
+      _counters.countRejected(LXDMX_REJECT_SHORT_PACKET);
+      return 0;
     }       // ACN packet identifier
   }			// preamble size
+  _counters.countPacket(SACN_COUNT_OTHER);		// not sACN, not a rejected DMX packet
+  return 0;
+}
+
+uint8_t LXSACN::other_universe( uint16_t size ) {
+  // same checks as parse_root_layer and parse_framing_layer up to the universe
+  if (( _packet_buffer[1] == 0x10 ) && ( strcmp((const char*)&_packet_buffer[4], "ASC-E1.17") == 0 )) {
+    if ( checkFlagsAndLength(&_packet_buffer[16], size - 16) && ( _packet_buffer[21] == 0x04 )) {
+      if ( checkFlagsAndLength(&_packet_buffer[38], size - 38) && ( _packet_buffer[43] == 0x02 )) {
+        return (( _packet_buffer[112] == 0 ) && ( _packet_buffer[114] != _universe ));
+      }
+    }
+  }
   return 0;
 }
 
@@ -237,10 +394,29 @@ uint16_t LXSACN::parse_framing_layer( uint16_t size ) {
    uint16_t tsize = size - 22;
    if ( checkFlagsAndLength(&_packet_buffer[38], tsize) ) {     // framing pdu length
      if ( _packet_buffer[43] == 0x02 ) {                        // vector dmp is 1.31
-        if (( _packet_buffer[112] == 0) && ( _packet_buffer[114] == _universe )) {	// implementation has 255 universe limit
-          return parse_dmp_layer( tsize );       					
-        }					// [112] options flags non-zero if preview or universe terminated
+        if ( _packet_buffer[112] == 0) {				// [112] options flags non-zero if preview or universe terminated
+          if ( _packet_buffer[114] == _universe ) {	// implementation has 255 universe limit
+            _changed_first = 0;
+            _changed_last = 0;
+            uint16_t result = parse_dmp_layer( tsize );
+            if ( result ) {
+              _dmx_received_time = micros();
+              if ( _latency_monitor != NULL ) {
+                _latency_monitor->packetReceived(_dmx_received_time);
+              }
+              if ( _packet_buffer[SACN_ADDRESS_OFFSET] == 0 ) {	// callback only for null start code
+                dmx_received();
+              }
+            }
+            return result;
+          }
+          _counters.countRejected(LXDMX_REJECT_WRONG_UNIVERSE);
+        }
+     } else {
+       _counters.countRejected(LXDMX_REJECT_BAD_HEADER);
      }
+   } else {
+     _counters.countRejected(LXDMX_REJECT_SHORT_PACKET);
    }
    return 0;
 }
@@ -291,7 +467,7 @@ uint16_t LXSACN::parse_dmp_layer( uint16_t size ) {
 						_dmx_sender_id[k] = _dmx_sender_id_b[k];
 						_dmx_sender_id_b[k] = 0;
 					}
-					for(int k=0; k<SLOTS_AND_START_CODE; k++) {
+					for(int k=0; k<_htp_size; k++) {
 						_dmx_buffer_a[k] = _dmx_buffer_b[k];
 						_dmx_buffer_b[k] = 0;
 					}
@@ -336,21 +512,33 @@ uint16_t LXSACN::parse_dmp_layer( uint16_t size ) {
 				   } else {
 						_dmx_slots = _dmx_slots_b;
 				   }
-				   for (di=0; di<_dmx_slots; di++) {
-						 _dmx_buffer_a[di] = _packet_buffer[dt+di];
-						if ( _dmx_buffer_a[di] > _dmx_buffer_b[di] ) {
-							_dmx_buffer_c[di] = _dmx_buffer_a[di];
+				   if ( _dmx_slots > _window_first + _htp_size ) {			// slots beyond window are not kept
+						_dmx_slots = _window_first + _htp_size;
+				   }
+				   for (di=_window_first; di<_dmx_slots; di++) {
+						uint16_t bi = di - _window_first;		// index in window buffers
+						 _dmx_buffer_a[bi] = _packet_buffer[dt+di];
+						if ( _dmx_buffer_a[bi] > _dmx_buffer_b[bi] ) {
+							set_merged_slot(di, _dmx_buffer_a[bi]);
 						} else {
-							_dmx_buffer_c[di] = _dmx_buffer_b[di];
+							set_merged_slot(di, _dmx_buffer_b[bi]);
 						}
 				   }			//for
 			   } else {
 			       _dmx_slots = _dmx_slots_a;
-			       for (di=0; di<_dmx_slots; di++) {
-						 _dmx_buffer_a[di] = _packet_buffer[dt+di];
-						 _dmx_buffer_c[di] = _dmx_buffer_a[di];
+				   if ( _dmx_slots > _window_first + _htp_size ) {
+						_dmx_slots = _window_first + _htp_size;
+				   }
+			       for (di=_window_first; di<_dmx_slots; di++) {
+						uint16_t bi = di - _window_first;		// index in window buffers
+						 _dmx_buffer_a[bi] = _packet_buffer[dt+di];
+						 set_merged_slot(di, _dmx_buffer_a[bi]);
 				   }
 			   }
+			   _counters.countAccepted(0);
+			   if (( _priority_a == _priority_b ) && _dmx_slots_b ) {
+			       _counters.countMerge();
+			   }
 		       return 1;
            } else if ( _packet_buffer[SACN_PRIORITY_OFFSET] == _priority_a ) {
            // if CID did not match sender_a and message has equal priority, this could be sender_b
@@ -365,21 +553,28 @@ uint16_t LXSACN::parse_dmp_layer( uint16_t size ) {
 				  } else {
 					 _dmx_slots = _dmx_slots_b;
 				  }
+				  if ( _dmx_slots > _window_first + _htp_size ) {
+					 _dmx_slots = _window_first + _htp_size;
+				  }
 
 				  int di;
 				  int dc = _dmx_slots;
 				  int dt = 125 + 1;
-				  for (di=0; di<dc; di++) {
-					 _dmx_buffer_b[di] = _packet_buffer[dt+di];
-					 if ( _dmx_buffer_a[di] > _dmx_buffer_b[di] ) {
-						_dmx_buffer_c[di] = _dmx_buffer_a[di];
+				  for (di=_window_first; di<dc; di++) {
+					uint16_t bi = di - _window_first;		// index in window buffers
+					 _dmx_buffer_b[bi] = _packet_buffer[dt+di];
+					 if ( _dmx_buffer_a[bi] > _dmx_buffer_b[bi] ) {
+					 	set_merged_slot(di, _dmx_buffer_a[bi]);
 					 } else {
-						_dmx_buffer_c[di] = _dmx_buffer_b[di];
+					 	set_merged_slot(di, _dmx_buffer_b[bi]);
 					 }
 				  }	//for
+				  _counters.countAccepted(1);
+				  _counters.countMerge();
 				  return 1;
 			  }	//matched second CID
            }		//not first CID and equal priority
+           _counters.countRejected(LXDMX_REJECT_WRONG_SENDER);
         } else {	//not _using_htp
 
 #if defined ( NO_HTP_IS_SINGLE_SENDER )
@@ -390,14 +585,20 @@ uint16_t LXSACN::parse_dmp_layer( uint16_t size ) {
 			    uint16_t slots = _packet_buffer[124];      // if same sender, good dmx!
 			    slots += _packet_buffer[123] << 8;
 			    _dmx_slots = slots - 1;
+			    _counters.countAccepted(0);
 			    return 1;
 #if defined ( NO_HTP_IS_SINGLE_SENDER )
 			  }
+			  _counters.countRejected(LXDMX_REJECT_WRONG_SENDER);
 #endif
         }
+        return 0;
       }
     }
+    _counters.countRejected(LXDMX_REJECT_BAD_HEADER);
+    return 0;
   }
+  _counters.countRejected(LXDMX_REJECT_SHORT_PACKET);
   return 0;
 }
 
@@ -416,15 +617,15 @@ uint8_t LXSACN::checkFlagsAndLength( uint8_t* flb, uint16_t size ) {
 
 
 void LXSACN::clearDMXOutput ( void ) {
-	for (int n=0; n<SLOTS_AND_START_CODE; n++) {
+	for (int n=0; n<_htp_size; n++) {
 	   _dmx_buffer_a[n] = 0;
 	   _dmx_buffer_b[n] = 0;
-	   _dmx_buffer_c[n] = 0;
-	   if ( n < SACN_CID_LENGTH ) {
-			_dmx_sender_id[n] = 0;
-			_dmx_sender_id_b[n] = 0;
+	   if ( _dmx_buffer_c != NULL ) {
+	   	  _dmx_buffer_c[n] = 0;
 	   }
     }
+    memset(_dmx_sender_id, 0, SACN_CID_LENGTH);
+    memset(_dmx_sender_id_b, 0, SACN_CID_LENGTH);
     
     _dmx_slots = 0;
     _dmx_slots_a = 0;
@@ -434,11 +635,86 @@ void LXSACN::clearDMXOutput ( void ) {
     _last_packet_a = 0;
 }
 
+void LXSACN::getCounters ( LXDMXCounters* c ) {
+	_counters.snapshot(c);
+}
+
+void LXSACN::resetCounters ( void ) {
+	_counters.reset();
+}
+
+uint32_t LXSACN::dmxReceivedTime ( void ) {
+	return _dmx_received_time;
+}
+
+void LXSACN::setLatencyMonitor ( LXDMXLatency* monitor ) {
+	_latency_monitor = monitor;
+}
+
+void LXSACN::setDMXReceivedCallback ( LXDMXReceivedCallback callback ) {
+	_dmx_received_callback = callback;
+}
+
+void LXSACN::setUniverseStore ( LXDMXUniverseStore* store, uint8_t index ) {
+	_universe_store = store;
+	_store_index = index;
+}
+
+void LXSACN::set_merged_slot ( uint16_t di, uint8_t value ) {
+	if ( _dmx_buffer_c == NULL ) {
+		// low memory HTP: previous merge is not kept, every slot is reported as changed
+		_packet_buffer[SACN_ADDRESS_OFFSET+1+di] = value;
+		if ( _changed_first == 0 ) {
+			_changed_first = di + 1;
+		}
+		_changed_last = di + 1;
+	} else if ( _dmx_buffer_c[di-_window_first] != value ) {
+		_dmx_buffer_c[di-_window_first] = value;
+		if ( _changed_first == 0 ) {
+			_changed_first = di + 1;
+		}
+		_changed_last = di + 1;		// slots are merged in ascending order
+	}
+}
+
+uint8_t* LXSACN::window_data ( void ) {
+	if ( _using_htp && ( _dmx_buffer_c != NULL )) {
+		return _dmx_buffer_c;
+	}
+	return &_packet_buffer[SACN_ADDRESS_OFFSET+1+_window_first];
+}
+
+uint16_t LXSACN::window_slots ( void ) {
+	if ( _dmx_slots <= _window_first ) {
+		return 0;
+	}
+	if ( _dmx_slots - _window_first > _htp_size ) {
+		return _htp_size;
+	}
+	return _dmx_slots - _window_first;
+}
+
+void LXSACN::dmx_received ( void ) {
+	if ( _universe_store != NULL ) {
+		_universe_store->update(_store_index, LXDMX_SOURCE_SACN, window_data(), window_slots(), _packet_buffer[SACN_PRIORITY_OFFSET]);
+	}
+	if ( _dmx_received_callback != NULL ) {
+		uint16_t count = window_slots();
+		if ( _using_htp ) {
+			_dmx_received_callback(_universe, window_data(), count, _changed_first, _changed_last);
+		} else if ( count ) {
+			_dmx_received_callback(_universe, window_data(), count, _window_first + 1, _window_first + count);
+		} else {
+			_dmx_received_callback(_universe, window_data(), 0, 0, 0);
+		}
+	}
+}
+
 void LXSACN::clearDMXSourceB( void ) {
 	for(int k=0; k<SACN_CID_LENGTH; k++) {
       _dmx_sender_id_b[k] = 0;
     }
-    for(int k=0; k<SLOTS_AND_START_CODE; k++) {
+    for(int k=0; k<_htp_size; k++) {
 		_dmx_buffer_b[k] = 0;
 	}
     _dmx_slots_b = 0;
@@ -18,9 +18,27 @@
 #define SACN_BUFFER_MAX 638
 #define SACN_PRIORITY_OFFSET 108
 #define SACN_ADDRESS_OFFSET 125
+// bytes read to check the universe of a data packet, up to but not including the start code
+#define SACN_HEADER_PEEK 125
 #define SACN_CID_LENGTH 16
 #define SLOTS_AND_START_CODE 513
 
+// LXDMXArena bytes used by an LXSACN constructed with an arena, for each configuration
+//
+//   configuration                               arena bytes
+//   packet buffer only                          SACN_ARENA_BYTES                   640
+//   enableHTP(arena)                            SACN_ARENA_BYTES_HTP              2176
+//   setSlotWindow(start, n), enableHTP(arena)   SACN_ARENA_BYTES_HTP_WINDOW(n)     640 + 3 x n (n rounded up to 4)
+//   enableLowMemoryHTP(n)                       SACN_ARENA_BYTES                   640, plus 2 x n from malloc
+#define SACN_ARENA_BYTES		LXDMX_ARENA_ALIGNED(SACN_BUFFER_MAX)
+#define SACN_ARENA_BYTES_HTP_WINDOW(n)	(SACN_ARENA_BYTES + 3 * LXDMX_ARENA_ALIGNED(n))
+#define SACN_ARENA_BYTES_HTP	SACN_ARENA_BYTES_HTP_WINDOW(DMX_UNIVERSE_SIZE)
+
+// LXDMXCounters type_count index for each root layer vector
+#define SACN_COUNT_OTHER	0
+#define SACN_COUNT_DATA		1		// VECTOR_ROOT_E131_DATA 0x04
+#define SACN_COUNT_EXTENDED	2		// VECTOR_ROOT_E131_EXTENDED 0x08 (sync, discovery)
+
 /*!
 * @class LXSACN
 * @abstract
@@ -44,6 +62,14 @@ class LXSACN : public LXDMXEthernet {
 */  
 	LXSACN ( uint8_t* buffer );
 /*!
+* @brief constructor for LXSACN with packet buffer taken from an arena
+* @discussion uses SACN_ARENA_BYTES.  If the arena is too small there is no packet buffer:
+*             dmxData() returns NULL, slot accessors read 0 and ignore writes, and no
+*             packets are read or sent.
+* @param arena LXDMXArena with at least SACN_ARENA_BYTES remaining
+*/  
+	LXSACN ( LXDMXArena* arena );
+/*!
 * @brief destructor for LXSACN  (frees packet buffer if allocated with constructor)
 */  	
    ~LXSACN ( void );
@@ -74,8 +100,52 @@ class LXSACN : public LXDMXEthernet {
                          Read the data from the HTP buffer using getHTPSlot(n).
                          enableHTP() is not available on an ATmega168, ATmega328, or
                          ATmega328P due to RAM size.
+                         If the buffers cannot be allocated, HTP is not enabled.
  */
    void    enableHTP();
+/*!
+ * @brief enables HTP merge with the three buffers taken from an arena instead of malloc
+ * @param arena LXDMXArena with SACN_ARENA_BYTES_HTP - SACN_ARENA_BYTES remaining
+ *              (SACN_ARENA_BYTES_HTP_WINDOW(n) - SACN_ARENA_BYTES after setSlotWindow)
+ * @return 1 if HTP is enabled
+ */
+   uint8_t enableHTP( LXDMXArena* arena );
+/*!
+ * @brief enables HTP merge from two sources using two buffers of the given size
+ * @discussion Only the per source buffers A and B are allocated (2 x slots bytes instead
+ *             of 3 x 512) and this is available on ATmega328 class boards.  Merged data is
+ *             written back into the packet buffer, so dmxData(), universeSpan() and the
+ *             LXDMXReceivedCallback see it until the next packet is read.  getHTPSlot()
+ *             computes max(A,B) on each call and stays valid.  Slots beyond the given size are
+ *             not received.  The trade off is a compare per getHTPSlot() call and that the
+ *             changed range in the callback is always the full range.
+ *
+ *             HTP buffer RAM (computed, in addition to the 638 byte packet buffer and,
+ *             on AVR, 2 bytes of malloc overhead per buffer):
+ *
+ *               mode                                 buffers   512 slots   64 slots
+ *               enableHTP()                          3 x 512     1536        1536
+ *               setSlotWindow(s, n), enableHTP()     3 x n       1536         192
+ *               enableLowMemoryHTP(n)                2 x n       1024         128
+ *
+ *             Per received slot each mode copies to A or B and compares A with B.  Full
+ *             and windowed HTP also compare with and write the merged buffer; low memory
+ *             HTP writes the packet buffer instead.  getHTPSlot() is one read for full and
+ *             windowed HTP, two reads and a compare for low memory HTP.
+ * @param slots number of slots to merge, 1-512.  For example, 64 uses 128 bytes.
+ * @return 1 if HTP is enabled
+ */
+   uint8_t enableLowMemoryHTP( uint16_t slots );
+/*!
+ * @brief receive only slots start to start+len-1
+ * @discussion Call before enableHTP() to allocate HTP buffers of len bytes instead of 512,
+ *             for a fixture that uses part of a universe.  Combined with enableLowMemoryHTP(n)
+ *             the buffers hold the first n slots of the window.
+ * @param start first slot 1-512
+ * @param len number of slots, reduced to fit the universe
+ * @return 1 if set, 0 if HTP is already enabled or start is invalid
+ */
+   uint8_t setSlotWindow( uint16_t start, uint16_t len );
 
  /*
  * @brief number of slots (aka addresses or channels)
@@ -108,6 +178,25 @@ class LXSACN : public LXDMXEthernet {
  * @param level 0 to 255
  */  
    void     setSlot      ( int slot, uint8_t value );
+ /*!
+ * @brief copy levels of consecutive slots
+ * @param start first slot 1 to 512
+ * @param count number of slots (limited to end of universe)
+ * @param dst array of at least count bytes
+ */  
+   void     getSlots     ( int start, int count, uint8_t* dst );
+ /*!
+ * @brief set levels of consecutive slots
+ * @param start first slot 1 to 512
+ * @param count number of slots (limited to end of universe)
+ * @param src array of at least count levels
+ */  
+   void     setSlots     ( int start, int count, const uint8_t* src );
+ /*!
+ * @brief view of received universe, merged if enableHTP() has been called
+ * @return LXDMXSpan with pointer to slot 1 and number of slots
+ */  
+   LXDMXSpan universeSpan ( void );
 /*!
 * @brief dmx start code (set to zero for standard dmx)
 * @return dmx start code
@@ -142,6 +231,9 @@ class LXSACN : public LXDMXEthernet {
    
  /*!
  * @brief process packet, reading it into _packet_buffer
+ * @discussion The header is read first.  A data packet for another universe is rejected
+ *             without reading its start code and data so the current universe's data and
+ *             number of slots are unchanged.
  * @param eUDP UDP*
  * @return number of dmx slots read or 0 if not dmx/invalid
  */
@@ -155,6 +247,52 @@ class LXSACN : public LXDMXEthernet {
 
 
 void clearDMXOutput ( void );
+
+/*!
+ * @brief copy snapshot of traffic counters
+ * @discussion type_count is indexed by SACN_COUNT_xxx
+ * @param c pointer to LXDMXCounters to receive snapshot
+ */
+   void  getCounters   ( LXDMXCounters* c );
+   
+/*!
+ * @brief zero traffic counters
+ */
+   void  resetCounters ( void );
+   
+/*!
+ * @brief time the current DMX data was received
+ * @discussion pass to LXDMXLatency outputComplete() when data has reached the output
+ * @return micros() when last DMX packet was accepted
+ */
+   uint32_t dmxReceivedTime   ( void );
+   
+/*!
+ * @brief set monitor to record arrival of each accepted DMX packet
+ * @param monitor LXDMXLatency for this universe or NULL
+ */
+   void     setLatencyMonitor ( LXDMXLatency* monitor );
+   
+/*!
+ * @brief set function called when DMX data for this universe is received
+ * @discussion called after readDMXPacket/readDMXPacketContents accepts DMX
+ * @param callback LXDMXReceivedCallback or NULL
+ */
+   void     setDMXReceivedCallback ( LXDMXReceivedCallback callback );
+   
+/*!
+ * @brief copy each DMX packet accepted to a universe of a shared store
+ * @discussion merged data is copied if enableHTP() has been called
+ * @param store LXDMXUniverseStore or NULL
+ * @param index universe index in store
+ */
+   void     setUniverseStore ( LXDMXUniverseStore* store, uint8_t index );
+   
+/*!
+ * @brief the packet buffer, slot n is at index address_offset + n
+ * @discussion Not virtual, so it is inlined by LXDMXNode.  NULL if allocation failed.
+ */
+   uint8_t* packetBuffer ( void ) { return _packet_buffer; }
    
   private:
 /*!
@@ -168,6 +306,12 @@ void clearDMXOutput ( void );
 * @brief indicates was created by constructor
 */
 	uint8_t   _owns_buffer;
+/// indicates HTP buffers were allocated with malloc and are freed by the destructor
+	uint8_t   _owns_htp_buffers;
+/// number of slots held in each HTP buffer (512 unless low memory HTP or a slot window)
+	uint16_t  _htp_size;
+/// index of the first slot in the window (slot number - 1), set by setSlotWindow
+	uint16_t  _window_first;
 /// number of slots/address/channels
   	int       _dmx_slots;
 /// universe 1-255 in this implementation
@@ -204,12 +348,33 @@ void clearDMXOutput ( void );
   	long      _last_packet_a;
 /// timestamp of last packet received from second sender 
   	long      _last_packet_b;
+  	
+/// packet and DMX counters
+  	LXDMXCounterSet _counters;
+/// micros() when last DMX packet was accepted
+  	uint32_t        _dmx_received_time;
+/// optional latency/inter-arrival monitor
+  	LXDMXLatency*   _latency_monitor;
+/// called when DMX is accepted
+  	LXDMXReceivedCallback _dmx_received_callback;
+/// first and last merged slot changed by current packet (HTP)
+  	uint16_t        _changed_first;
+  	uint16_t        _changed_last;
+/// optional store shared with other receivers
+  	LXDMXUniverseStore* _universe_store;
+/// universe index in _universe_store
+  	uint8_t         _store_index;
 
 /*!
 * @brief checks the buffer for the sACN header and root layer size
 */  	
   	uint16_t  parse_root_layer    ( int size );
 /*!
+* @brief true if header in packet buffer is a data packet for a different universe
+* @param size size of packet
+*/  	
+  	uint8_t   other_universe      ( uint16_t size );
+/*!
 * @brief checks the buffer for the sACN header and root layer size
 */  
   	uint16_t  parse_framing_layer ( uint16_t size );	
@@ -229,11 +394,27 @@ void clearDMXOutput ( void );
 * @brief copies CID from packet to array (if empty)
 */
   	void      copyCIDifEmpty      ( uint8_t* cid );
+/*!
+* @brief write slot of HTP buffer, recording changed range
+*/
+  	void      set_merged_slot     ( uint16_t di, uint8_t value );
+/*!
+* @brief first slot of the window, in HTP buffer C or the packet buffer
+*/
+  	uint8_t*  window_data         ( void );
+/*!
+* @brief number of received slots within the window
+*/
+  	uint16_t  window_slots        ( void );
+/*!
+* @brief pass received DMX to _universe_store and _dmx_received_callback
+*/
+  	void      dmx_received        ( void );
   	
 /*!
 * @brief initialize data structures
 */
-   void  initialize  ( uint8_t* b );
+   void  initialize  ( uint8_t* b, uint8_t owns );
    
  /*!
  * @brief clear "b" dmx buffer and sender CID